@@ -30,12 +30,12 @@ typedef flutter::MethodResult<EncodableValue> MethodResult;
 // foo.IsString() becomes std::holds_alternative<std::string>(foo)
 
 template <typename T>
-inline bool TypeIs(const EncodableValue val) {
+inline bool TypeIs(const EncodableValue& val) {
   return std::holds_alternative<T>(val);
 }
 
 template <typename T>
-inline const T GetValue(EncodableValue val) {
+inline const T GetValue(const EncodableValue& val) {
   return std::get<T>(val);
 }
 
@@ -107,6 +107,18 @@ inline int toInt(flutter::EncodableValue inputVal, int defaultVal) {
   return intValue;
 }
 
+inline double toDouble(flutter::EncodableValue inputVal, double defaultVal) {
+  double doubleValue = defaultVal;
+  if (TypeIs<double>(inputVal)) {
+    doubleValue = GetValue<double>(inputVal);
+  } else if (TypeIs<int32_t>(inputVal)) {
+    doubleValue = GetValue<int32_t>(inputVal);
+  } else if (TypeIs<int64_t>(inputVal)) {
+    doubleValue = static_cast<double>(GetValue<int64_t>(inputVal));
+  }
+  return doubleValue;
+}
+
 class MethodCallProxy {
  public:
   static std::unique_ptr<MethodCallProxy> Create(const MethodCall& call);
@@ -145,13 +157,45 @@ class MethodResultProxy {
 
 class EventChannelProxy {
  public:
+  // Makes the proxy cache every event until Dart listens. Channels whose
+  // events must not be lost, such as those of peer connections and data
+  // channels, use it.
+  static constexpr size_t kUnbounded = 0;
+
+  struct QueueStats {
+    // The number of events currently cached.
+    size_t queue_depth = 0;
+    size_t max_queue_depth = 0;
+    size_t dropped_events = 0;
+    // Events replaced by a later event of the same type.
+    size_t coalesced_events = 0;
+    // The number of times events were delivered to the platform thread.
+    size_t batches = 0;
+  };
+
+  // Until Dart listens, at most |max_queued_events| events are cached and
+  // the oldest ones are dropped first, unless it is kUnbounded.
   static std::unique_ptr<EventChannelProxy> Create(
-      BinaryMessenger* messenger, const std::string& channelName);
+      BinaryMessenger* messenger, const std::string& channelName,
+      size_t max_queued_events);
 
   virtual ~EventChannelProxy() = default;
 
+  // Must be called on the platform thread.
+  virtual QueueStats queue_stats() const = 0;
+
+  // Delivers |event| on the platform thread. If nobody listens yet, the
+  // event is cached if |cache_event| is true.
   virtual void Success(const EncodableValue& event,
                        bool cache_event = true) = 0;
+
+  // Sends runs of |event_type| events that reach the platform thread together
+  // as a single list on the event channel |channel_name|, which is created on
+  // the first call, instead of one by one. The batch channel never drops
+  // events. An empty |event_type| stops batching. Events keep their order
+  // across both channels. Must be called on the platform thread.
+  virtual void SetBatchChannel(const std::string& event_type,
+                               const std::string& channel_name) = 0;
 };
 
 #endif  // FLUTTER_WEBRTC_COMMON_HXX
@@ -19,6 +19,11 @@ class FlutterRTCDataChannelObserver : public RTCDataChannelObserver {
 
   scoped_refptr<RTCDataChannel> data_channel() { return data_channel_; }
 
+  // If |batched| is true, "dataChannelReceiveMessage" events received in a
+  // row are delivered as a single list on |channel_name| instead of one by
+  // one on the data channel event channel.
+  void SetBatched(bool batched, const std::string& channel_name);
+
  private:
   std::unique_ptr<EventChannelProxy> event_channel_;
   scoped_refptr<RTCDataChannel> data_channel_;
@@ -38,11 +43,15 @@ class FlutterDataChannel {
                        const EncodableValue& data,
                        std::unique_ptr<MethodResultProxy>);
 
+  void DataChannelSetBatched(const std::string& data_channel_uuid,
+                             bool batched,
+                             std::unique_ptr<MethodResultProxy>);
+
   void DataChannelClose(RTCDataChannel* data_channel,
                         const std::string& data_channel_uuid,
                         std::unique_ptr<MethodResultProxy>);
 
-  RTCDataChannel* DataChannelForId(const std::string& id);
+  scoped_refptr<RTCDataChannel> DataChannelForId(const std::string& id);
 
  private:
   FlutterWebRTCBase* base_;
@@ -0,0 +1,69 @@
+#ifndef FLUTTER_WEBRTC_RTC_FRAME_CAPTURER_HXX
+#define FLUTTER_WEBRTC_RTC_FRAME_CAPTURER_HXX
+
+#include <Ecore.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter_common.h"
+#include "rtc_video_frame.h"
+#include "rtc_video_renderer.h"
+#include "rtc_video_track.h"
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+// Captures the next frame of a video track, rotates it upright and encodes it
+// to JPEG or PNG.
+//
+// The capturer is attached to the track as a one-shot renderer. The frame
+// delivery thread only keeps a reference to the frame; conversion and
+// encoding run on a worker thread. The capturer deletes itself after
+// completing |result|.
+class FlutterFrameCapturer
+    : public RTCVideoRenderer<scoped_refptr<RTCVideoFrame>> {
+ public:
+  enum class Format { kJpeg, kPng };
+
+  // Starts capturing. If |path| is empty, the encoded bytes are returned
+  // through |result| instead of being written to a file.
+  static void Capture(scoped_refptr<RTCVideoTrack> track,
+                      const std::string &path, Format format,
+                      std::unique_ptr<MethodResultProxy> result);
+
+  virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
+
+ private:
+  FlutterFrameCapturer(scoped_refptr<RTCVideoTrack> track,
+                       const std::string &path, Format format,
+                       std::unique_ptr<MethodResultProxy> result);
+  ~FlutterFrameCapturer();
+
+  // Detaches from the track and completes |result_| with an error.
+  void Fail(const std::string &message);
+
+  static void OnFrameCaptured(void *data);
+  static Eina_Bool OnTimeout(void *data);
+  static void OnEncode(void *data, Ecore_Thread *thread);
+  static void OnEncodeEnd(void *data, Ecore_Thread *thread);
+
+  scoped_refptr<RTCVideoTrack> track_;
+  std::string path_;
+  Format format_;
+  std::unique_ptr<MethodResultProxy> result_;
+  std::atomic<bool> has_frame_ = false;
+  scoped_refptr<RTCVideoFrame> frame_;
+  Ecore_Timer *timeout_timer_ = nullptr;
+  // Written by the worker thread.
+  bool is_encoded_ = false;
+  std::vector<uint8_t> encoded_;
+  std::string error_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_FRAME_CAPTURER_HXX
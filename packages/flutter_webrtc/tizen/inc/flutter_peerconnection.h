@@ -1,7 +1,15 @@
 #ifndef FLUTTER_WEBRTC_RTC_PEER_CONNECTION_HXX
 #define FLUTTER_WEBRTC_RTC_PEER_CONNECTION_HXX
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "flutter_common.h"
+#include "flutter_sender_adaptation.h"
+#include "flutter_stats_stream.h"
 #include "flutter_webrtc_base.h"
 
 namespace flutter_webrtc_plugin {
@@ -40,7 +48,9 @@ class FlutterPeerConnectionObserver : public RTCPeerConnectionObserver {
  private:
   std::unique_ptr<EventChannelProxy> event_channel_;
   scoped_refptr<RTCPeerConnection> peerconnection_;
+  // Written on the signaling thread and read on the platform thread.
   std::map<std::string, scoped_refptr<RTCMediaStream>> remote_streams_;
+  std::mutex remote_streams_mutex_;
   FlutterWebRTCBase* base_;
   std::string id_;
 };
@@ -86,6 +96,11 @@ class FlutterPeerConnection {
   libwebrtc::scoped_refptr<libwebrtc::RTCRtpEncodingParameters> mapToEncoding(
       const EncodableMap& parameters);
 
+  // Returns |layers| (2 or 3) simulcast encodings, or none if |layers| is
+  // less than 2.
+  std::vector<scoped_refptr<RTCRtpEncodingParameters>> simulcastEncodings(
+      int layers);
+
   void AddTransceiver(RTCPeerConnection* pc, const std::string& trackId,
                       const std::string& mediaType,
                       const EncodableMap& transceiverInit,
@@ -126,7 +141,10 @@ class FlutterPeerConnection {
                         const EncodableMap& configuration,
                         std::unique_ptr<MethodResultProxy> resulte);
 
-  void CaptureFrame(RTCVideoTrack* track, std::string path,
+  // Encodes the next frame of |track| to |path|, or returns the encoded
+  // bytes if |path| is empty. |format| is "jpeg" or "png"; if it is empty,
+  // the format is derived from the extension of |path|.
+  void CaptureFrame(RTCVideoTrack* track, std::string path, std::string format,
                     std::unique_ptr<MethodResultProxy> resulte);
 
   scoped_refptr<RTCRtpTransceiver> getRtpTransceiverById(RTCPeerConnection* pc,
@@ -143,6 +161,26 @@ class FlutterPeerConnection {
   void AddIceCandidate(RTCIceCandidate* candidate, RTCPeerConnection* pc,
                        std::unique_ptr<MethodResultProxy> result);
 
+  // Emits derived stats of |pc| every |interval| seconds as "statsReport"
+  // events on "FlutterWebRTC/peerConnectionStats<uuid>".
+  void StartStatsStreaming(RTCPeerConnection* pc, const std::string& uuid,
+                           double interval,
+                           const std::vector<std::string>& fields,
+                           std::unique_ptr<MethodResultProxy> result);
+
+  void StopStatsStreaming(const std::string& uuid,
+                          std::unique_ptr<MethodResultProxy> result);
+
+  // Scales down the video senders of |pc| while the CPU is overloaded and
+  // emits the changes as "senderAdaptationChanged" events on
+  // "FlutterWebRTC/peerConnectionAdaptation<uuid>".
+  void StartSenderAdaptation(RTCPeerConnection* pc, const std::string& uuid,
+                             const FlutterSenderAdaptation::Config& config,
+                             std::unique_ptr<MethodResultProxy> result);
+
+  void StopSenderAdaptation(const std::string& uuid,
+                            std::unique_ptr<MethodResultProxy> result);
+
   void GetStats(const std::string& track_id, RTCPeerConnection* pc,
                 std::unique_ptr<MethodResultProxy> result);
 
@@ -166,6 +204,9 @@ class FlutterPeerConnection {
 
  private:
   FlutterWebRTCBase* base_;
+  std::map<std::string, std::unique_ptr<FlutterStatsStream>> stats_streams_;
+  std::map<std::string, std::unique_ptr<FlutterSenderAdaptation>>
+      sender_adaptations_;
 };
 }  // namespace flutter_webrtc_plugin
 
@@ -0,0 +1,87 @@
+#ifndef FLUTTER_WEBRTC_RTC_SENDER_ADAPTATION_HXX
+#define FLUTTER_WEBRTC_RTC_SENDER_ADAPTATION_HXX
+
+#include <Ecore.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter_common.h"
+#include "rtc_peerconnection.h"
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+// Samples the CPU usage of the device periodically and scales down the
+// resolution and frame rate of the video senders of a peer connection while
+// the CPU is overloaded, so that encoding does not starve decoding and
+// rendering. Every change of the adaptation level is emitted as a
+// "senderAdaptationChanged" event.
+class FlutterSenderAdaptation {
+ public:
+  struct Config {
+    // In seconds.
+    double interval = 2.0;
+    // The level is raised as soon as the CPU usage (0 to 100) reaches
+    // |high_cpu_usage| and lowered after it stays below |low_cpu_usage| for
+    // |recovery_samples| consecutive samples.
+    double high_cpu_usage = 85.0;
+    double low_cpu_usage = 60.0;
+    int recovery_samples = 3;
+    // The frame rate assumed for encodings without a maximum frame rate when
+    // deciding whether a step lowers it.
+    double max_framerate = 30.0;
+  };
+
+  FlutterSenderAdaptation(scoped_refptr<RTCPeerConnection> pc,
+                          BinaryMessenger *messenger,
+                          const std::string &channel_name,
+                          const Config &config);
+  // Restores the original encoding parameters of the senders.
+  ~FlutterSenderAdaptation();
+
+ private:
+  struct Encoding {
+    // As read from the sender, restored as is at level 0. A max_framerate of
+    // 0 is how an unset maximum frame rate reads.
+    double scale_resolution_down_by = 1.0;
+    double max_framerate = 0.0;
+    // As last written by ApplyLevel(), to detect changes made by the app.
+    bool is_applied = false;
+    double applied_scale_resolution_down_by = 0.0;
+    double applied_max_framerate = 0.0;
+  };
+
+  static Encoding ReadEncoding(RTCRtpEncodingParameters *encoding);
+
+  static Eina_Bool OnInterval(void *data);
+
+  bool SampleCpuUsage(double *usage);
+  void SetLevel(int level, double cpu_usage);
+  // Records the encodings of the video senders of |pc_| as the parameters of
+  // level 0.
+  void SnapshotEncodings();
+  // Applies |level_| to the video senders of |pc_|. Encodings of new senders,
+  // and encodings changed by the app since they were last applied, are
+  // recorded as the parameters of level 0 first.
+  EncodableList ApplyLevel();
+
+  scoped_refptr<RTCPeerConnection> pc_;
+  std::unique_ptr<EventChannelProxy> event_channel_;
+  Config config_;
+  Ecore_Timer *timer_ = nullptr;
+  int level_ = 0;
+  int recovery_count_ = 0;
+  uint64_t previous_busy_ = 0;
+  uint64_t previous_total_ = 0;
+  // Keyed by sender ID.
+  std::map<std::string, std::vector<Encoding>> original_encodings_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_SENDER_ADAPTATION_HXX
@@ -0,0 +1,65 @@
+#ifndef FLUTTER_WEBRTC_RTC_STATS_STREAM_HXX
+#define FLUTTER_WEBRTC_RTC_STATS_STREAM_HXX
+
+#include <Ecore.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter_common.h"
+#include "rtc_peerconnection.h"
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+// Collects the stats of a peer connection periodically and emits only
+// derived values (bitrates, packet loss, jitter, etc.) as compact
+// "statsReport" events, so that Dart does not have to poll and diff full
+// reports.
+class FlutterStatsStream {
+ public:
+  // |fields| selects the derived values to emit. All values are emitted if
+  // it is empty.
+  FlutterStatsStream(scoped_refptr<RTCPeerConnection> pc,
+                     BinaryMessenger *messenger,
+                     const std::string &channel_name, double interval,
+                     const std::vector<std::string> &fields);
+  ~FlutterStatsStream();
+
+ private:
+  struct Sample {
+    int64_t timestamp_us = 0;
+    int64_t bytes = 0;
+    int64_t packets = 0;
+    int64_t packets_lost = 0;
+  };
+
+  // Shared with pending stats callbacks, which may complete on the
+  // signaling thread after the stream is stopped.
+  struct State {
+    std::mutex mutex;
+    bool is_active = true;
+    bool is_collecting = false;
+    std::vector<std::string> fields;
+    std::map<std::string, Sample> previous_samples;
+    // Only dereferenced with |mutex| held while |is_active| is true.
+    EventChannelProxy *event_channel = nullptr;
+  };
+
+  static Eina_Bool OnInterval(void *data);
+  static EncodableValue Summarize(
+      State *state, const vector<scoped_refptr<MediaRTCStats>> &reports);
+
+  scoped_refptr<RTCPeerConnection> pc_;
+  std::unique_ptr<EventChannelProxy> event_channel_;
+  std::shared_ptr<State> state_;
+  Ecore_Timer *timer_ = nullptr;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_STATS_STREAM_HXX
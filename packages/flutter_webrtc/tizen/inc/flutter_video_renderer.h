@@ -1,12 +1,17 @@
 #ifndef FLUTTER_WEBRTC_RTC_VIDEO_RENDERER_HXX
 #define FLUTTER_WEBRTC_RTC_VIDEO_RENDERER_HXX
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <vector>
 
 #include "flutter_common.h"
 #include "flutter_webrtc_base.h"
 #include "rtc_video_frame.h"
 #include "rtc_video_renderer.h"
+#include "video_buffer_pool.h"
 
 namespace flutter_webrtc_plugin {
 
@@ -15,15 +20,36 @@ using namespace libwebrtc;
 class FlutterVideoRenderer
     : public RTCVideoRenderer<scoped_refptr<RTCVideoFrame>> {
  public:
-  FlutterVideoRenderer(TextureRegistrar *registrar, BinaryMessenger *messenger);
+  // If |use_gpu_surface| is true and the platform supports it, frames are
+  // presented as NV12 tbm surfaces instead of RGBA pixel buffers.
+  FlutterVideoRenderer(TextureRegistrar *registrar, BinaryMessenger *messenger,
+                       bool use_gpu_surface = false);
 
   virtual const FlutterDesktopPixelBuffer *CopyPixelBuffer(size_t width,
                                                            size_t height) const;
 
+  const FlutterDesktopGpuSurfaceDescriptor *ObtainGpuSurface(size_t width,
+                                                             size_t height);
+
   virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
 
   void SetVideoTrack(scoped_refptr<RTCVideoTrack> track);
 
+  // Stops presenting frames while |paused| is true. If |keep_latest_frame|
+  // is true, the renderer stays attached to the track and keeps only the
+  // latest frame, unconverted, to present it when resumed. Otherwise it is
+  // detached from the track. Can be called again while paused to switch
+  // between the two.
+  void SetPaused(bool paused, bool keep_latest_frame);
+
+  // Presents at most |fps| frames per second. 0 means unlimited.
+  void SetMaxFrameRate(double fps);
+
+  // Converts frames larger than |width| x |height| down to fit in that size,
+  // keeping the aspect ratio. 0 means the frame size. Only applies to pixel
+  // buffers.
+  void SetTargetSize(size_t width, size_t height);
+
   int64_t texture_id() { return texture_id_; }
 
   bool CheckMediaStream(std::string mediaId);
@@ -37,17 +63,53 @@ class FlutterVideoRenderer
     size_t width;
     size_t height;
   };
+  struct FrameBuffer {
+    std::vector<uint8_t> data;
+    size_t width = 0;
+    size_t height = 0;
+  };
+  // Converts |frame| into the buffer owned by the frame-delivery thread.
+  void ConvertFrame(const scoped_refptr<RTCVideoFrame> &frame);
+  // Writes |frame| into a pooled surface and makes it the pending frame.
+  bool WriteGpuSurface(const scoped_refptr<RTCVideoFrame> &frame);
+  // Converts |frame| and notifies the engine unless a frame is pending.
+  void PresentFrame(const scoped_refptr<RTCVideoFrame> &frame);
   FrameSize last_frame_size_ = {0, 0};
   bool first_frame_rendered = false;
   TextureRegistrar *registrar_ = nullptr;
   std::unique_ptr<EventChannelProxy> event_channel_;
   int64_t texture_id_ = -1;
   scoped_refptr<RTCVideoTrack> track_ = nullptr;
-  scoped_refptr<RTCVideoFrame> frame_;
   std::unique_ptr<flutter::TextureVariant> texture_;
-  std::shared_ptr<FlutterDesktopPixelBuffer> pixel_buffer_;
-  mutable std::shared_ptr<uint8_t> rgb_buffer_;
+  // Frames are converted on the frame-delivery thread. One buffer is being
+  // written, one holds the latest converted frame and one is being read by
+  // the raster thread. |mutex_| only guards swapping the indices.
+  mutable std::array<FrameBuffer, 3> frame_buffers_;
+  size_t write_index_ = 0;
+  mutable size_t pending_index_ = 1;
+  mutable size_t display_index_ = 2;
+  mutable bool has_pending_frame_ = false;
+  mutable FlutterDesktopPixelBuffer pixel_buffer_ = {};
   mutable std::mutex mutex_;
+  size_t dropped_frame_count_ = 0;
+  std::atomic<bool> is_paused_ = false;
+  // Only accessed on the platform thread.
+  bool is_detached_ = false;
+  // Guarded by |mutex_|.
+  scoped_refptr<RTCVideoFrame> latest_frame_;
+  // 0 means unlimited.
+  std::atomic<int64_t> min_frame_interval_us_ = 0;
+  // Only accessed on the frame-delivery thread.
+  std::chrono::steady_clock::time_point next_frame_time_;
+  size_t throttled_frame_count_ = 0;
+  // Set by the app. The engine always requests the frame size, so it cannot
+  // tell the size the texture is displayed at.
+  std::atomic<size_t> target_width_ = 0;
+  std::atomic<size_t> target_height_ = 0;
+  // Only used in the GPU surface mode.
+  std::unique_ptr<VideoBufferPool> buffer_pool_;
+  VideoBufferUnit *pending_surface_ = nullptr;
+  VideoBufferUnit *display_surface_ = nullptr;
   RTCVideoFrame::VideoRotation rotation_ = RTCVideoFrame::kVideoRotation_0;
 };
 
@@ -63,8 +125,24 @@ class FlutterVideoRendererManager {
   void VideoRendererDispose(int64_t texture_id,
                             std::unique_ptr<MethodResultProxy> result);
 
+  // Selects whether renderers created from now on present frames as GPU
+  // surfaces ("gpuSurface") or pixel buffers ("pixelBuffer").
+  bool SetVideoRendererMode(const std::string &mode);
+
+  void VideoRendererSetPaused(int64_t texture_id, bool paused,
+                              bool keep_latest_frame,
+                              std::unique_ptr<MethodResultProxy> result);
+
+  void VideoRendererSetMaxFrameRate(int64_t texture_id, double fps,
+                                    std::unique_ptr<MethodResultProxy> result);
+
+  void VideoRendererSetTargetSize(int64_t texture_id, int32_t width,
+                                  int32_t height,
+                                  std::unique_ptr<MethodResultProxy> result);
+
  private:
   FlutterWebRTCBase *base_;
+  bool use_gpu_surface_ = false;
   std::map<int64_t, std::unique_ptr<FlutterVideoRenderer>> renderers_;
 };
 
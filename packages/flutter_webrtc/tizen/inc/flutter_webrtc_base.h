@@ -6,7 +6,9 @@
 #include <list>
 #include <map>
 #include <memory>
-#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter_common.h"
 #include "libwebrtc.h"
@@ -43,24 +45,49 @@ class FlutterWebRTCBase {
 
   std::string GenerateUUID();
 
-  RTCPeerConnection* PeerConnectionForId(const std::string& id);
+  // Lookups return references so that the objects stay alive when another
+  // thread removes them from their registry.
+  scoped_refptr<RTCPeerConnection> PeerConnectionForId(const std::string& id);
+
+  void AddPeerConnection(const std::string& id,
+                         scoped_refptr<RTCPeerConnection> pc);
 
   void RemovePeerConnectionForId(const std::string& id);
 
-  RTCMediaTrack* MediaTrackForId(const std::string& id);
+  scoped_refptr<RTCMediaTrack> MediaTrackForId(const std::string& id);
+
+  void AddMediaTrack(scoped_refptr<RTCMediaTrack> track);
 
   void RemoveMediaTrackForId(const std::string& id);
 
-  FlutterPeerConnectionObserver* PeerConnectionObserversForId(
+  std::shared_ptr<FlutterPeerConnectionObserver> PeerConnectionObserversForId(
       const std::string& id);
 
+  void AddPeerConnectionObserver(
+      const std::string& id,
+      std::shared_ptr<FlutterPeerConnectionObserver> observer);
+
   void RemovePeerConnectionObserversForId(const std::string& id);
 
+  std::shared_ptr<FlutterRTCDataChannelObserver> DataChannelObserverForId(
+      const std::string& id);
+
+  void AddDataChannelObserver(
+      const std::string& id,
+      std::shared_ptr<FlutterRTCDataChannelObserver> observer);
+
+  void RemoveDataChannelObserverForId(const std::string& id);
+
   scoped_refptr<RTCMediaStream> MediaStreamForId(
       const std::string& id, std::string peerConnectionId = std::string());
 
+  void AddMediaStream(const std::string& id,
+                      scoped_refptr<RTCMediaStream> stream);
+
   void RemoveStreamForId(const std::string& id);
 
+  std::vector<scoped_refptr<RTCMediaStream>> LocalMediaStreams();
+
   bool ParseConstraints(const EncodableMap& constraints,
                         RTCConfiguration* configuration);
 
@@ -84,24 +111,38 @@ class FlutterWebRTCBase {
   bool CreateIceServers(const EncodableList& iceServersArray,
                         IceServer* ice_servers);
 
+  // Copied so that each observer can be queried without holding
+  // |observers_mutex_|.
+  std::vector<std::shared_ptr<FlutterPeerConnectionObserver>>
+  PeerConnectionObservers() const;
+
  protected:
   scoped_refptr<RTCPeerConnectionFactory> factory_;
   scoped_refptr<RTCAudioDevice> audio_device_;
   scoped_refptr<RTCVideoDevice> video_device_;
   RTCConfiguration configuration_;
 
-  std::map<std::string, scoped_refptr<RTCPeerConnection>> peerconnections_;
-  std::map<std::string, scoped_refptr<RTCMediaStream>> local_streams_;
-  std::map<std::string, scoped_refptr<RTCMediaTrack>> local_tracks_;
+  // Each registry has its own lock so that lookups (shared) on one registry
+  // do not wait for insertions (exclusive) into another, e.g. data channels
+  // opened on the signaling thread while a peer connection is being created.
+  // Never hold more than one of these locks at a time.
+  std::unordered_map<std::string, scoped_refptr<RTCPeerConnection>>
+      peerconnections_;
+  std::unordered_map<std::string, scoped_refptr<RTCMediaStream>>
+      local_streams_;
+  std::unordered_map<std::string, scoped_refptr<RTCMediaTrack>> local_tracks_;
   std::map<int64_t, std::shared_ptr<FlutterVideoRenderer>> renders_;
-  std::map<std::string, std::shared_ptr<FlutterRTCDataChannelObserver>>
+  std::unordered_map<std::string,
+                     std::shared_ptr<FlutterRTCDataChannelObserver>>
       data_channel_observers_;
-  std::map<std::string, std::shared_ptr<FlutterPeerConnectionObserver>>
+  std::unordered_map<std::string,
+                     std::shared_ptr<FlutterPeerConnectionObserver>>
       peerconnection_observers_;
-  mutable std::mutex mutex_;
-
-  void lock() { mutex_.lock(); }
-  void unlock() { mutex_.unlock(); }
+  mutable std::shared_mutex peerconnections_mutex_;
+  mutable std::shared_mutex streams_mutex_;
+  mutable std::shared_mutex tracks_mutex_;
+  mutable std::shared_mutex data_channels_mutex_;
+  mutable std::shared_mutex observers_mutex_;
 
  protected:
   BinaryMessenger* messenger_;
@@ -0,0 +1,68 @@
+#ifndef FLUTTER_WEBRTC_VIDEO_BUFFER_POOL_HXX
+#define FLUTTER_WEBRTC_VIDEO_BUFFER_POOL_HXX
+
+#include <flutter_texture_registrar.h>
+#include <tbm_surface.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rtc_video_frame.h"
+
+namespace flutter_webrtc_plugin {
+
+// An NV12 tbm surface that a video frame is written into and presented to
+// the engine as a GPU surface, so that colour conversion happens in the
+// compositor.
+class VideoBufferUnit {
+ public:
+  VideoBufferUnit();
+  ~VideoBufferUnit();
+
+  // Copies the planes of |frame| into the surface, reallocating it if the
+  // frame size changed. Returns false if the surface is not available.
+  bool Write(libwebrtc::RTCVideoFrame *frame);
+
+  // Called every time the buffer is handed to the engine, which happens on
+  // every raster frame while it is displayed. The buffer is not reused until
+  // the engine has invoked |release_callback| of the GPU surface once for each
+  // call.
+  void MarkHeldByEngine() { hold_count_++; }
+
+  FlutterDesktopGpuSurfaceDescriptor *GpuSurface() { return &gpu_surface_; }
+
+ private:
+  friend class VideoBufferPool;
+
+  static void OnReleased(void *release_context);
+
+  bool is_used_ = false;
+  std::atomic<int32_t> hold_count_ = 0;
+  int32_t width_ = 0;
+  int32_t height_ = 0;
+  tbm_surface_h tbm_surface_ = nullptr;
+  FlutterDesktopGpuSurfaceDescriptor gpu_surface_ = {};
+};
+
+class VideoBufferPool {
+ public:
+  explicit VideoBufferPool(size_t pool_size);
+
+  // Whether the platform can allocate NV12 tbm surfaces.
+  static bool IsSupported();
+
+  // Returns a buffer which is neither used nor held by the engine, or null
+  // if all buffers are busy.
+  VideoBufferUnit *GetAvailableBuffer();
+  void Release(VideoBufferUnit *buffer);
+
+ private:
+  std::vector<std::unique_ptr<VideoBufferUnit>> pool_;
+  std::mutex mutex_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_VIDEO_BUFFER_POOL_HXX
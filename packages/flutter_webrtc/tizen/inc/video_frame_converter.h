@@ -0,0 +1,24 @@
+#ifndef FLUTTER_WEBRTC_VIDEO_FRAME_CONVERTER_HXX
+#define FLUTTER_WEBRTC_VIDEO_FRAME_CONVERTER_HXX
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flutter_webrtc_plugin {
+
+// Converts an I420 (BT.601, limited range) image to RGBA bytes in memory
+// order, which is what RTCVideoFrame::Type::kABGR produces and what Flutter
+// pixel buffers expect.
+//
+// If |dst_width| and |dst_height| are smaller than the source size, the image
+// is downscaled by point sampling so that only the sampled pixels are
+// converted. |dst| must hold |dst_width| * |dst_height| * 4 bytes.
+void ConvertI420ToRgba(const uint8_t *src_y, int stride_y,
+                       const uint8_t *src_u, int stride_u,
+                       const uint8_t *src_v, int stride_v, int src_width,
+                       int src_height, uint8_t *dst, int dst_width,
+                       int dst_height);
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_VIDEO_FRAME_CONVERTER_HXX
@@ -5,6 +5,17 @@
 
 #include "flutter_common.h"
 
+#include <Ecore.h>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "log.h"
+
 class MethodCallProxyImpl : public MethodCallProxy {
  public:
   MethodCallProxyImpl(const MethodCall& method_call)
@@ -69,13 +80,42 @@ std::unique_ptr<MethodResultProxy> MethodResultProxy::Create(
   return std::make_unique<MethodResultProxyImpl>(std::move(method_result));
 }
 
+namespace {
+
+// Channels that never drop events warn each time this many more events are
+// cached.
+constexpr size_t kQueueDepthWarningStep = 1024;
+
+// Events of these types describe a state, so only the latest one is worth
+// delivering to a listener that subscribes late.
+const std::set<std::string> kCoalescedEvents = {
+    "didTextureChangeVideoSize",
+    "didTextureChangeRotation",
+};
+
+std::string EventType(const EncodableValue& event) {
+  const auto* map = std::get_if<EncodableMap>(&event);
+  if (!map) {
+    return std::string();
+  }
+  return findString(*map, "event");
+}
+
+}  // namespace
+
 class EventChannelProxyImpl : public EventChannelProxy {
  public:
   EventChannelProxyImpl(BinaryMessenger* messenger,
-                        const std::string& channelName)
-      : channel_(std::make_unique<EventChannel>(
+                        const std::string& channelName,
+                        size_t max_queued_events)
+      : messenger_(messenger),
+        channel_name_(channelName),
+        channel_(std::make_unique<EventChannel>(
             messenger, channelName,
-            &flutter::StandardMethodCodec::GetInstance())) {
+            &flutter::StandardMethodCodec::GetInstance())),
+        max_queued_events_(max_queued_events),
+        pending_(std::make_shared<PendingEvents>()) {
+    pending_->proxy = this;
     auto handler = std::make_unique<
         flutter::StreamHandlerFunctions<EncodableValue>>(
         [&](const EncodableValue* arguments,
@@ -97,25 +137,170 @@ class EventChannelProxyImpl : public EventChannelProxy {
     channel_->SetStreamHandler(std::move(handler));
   }
 
-  virtual ~EventChannelProxyImpl() {}
+  virtual ~EventChannelProxyImpl() {
+    {
+      std::lock_guard<std::mutex> lock(pending_->mutex);
+      pending_->proxy = nullptr;
+      pending_->events.clear();
+    }
+    QueueStats stats = queue_stats();
+    LOG_DEBUG(
+        "%s: max queue depth %zu, dropped %zu, coalesced %zu, batches %zu",
+        channel_name_.c_str(), stats.max_queue_depth, stats.dropped_events,
+        stats.coalesced_events, stats.batches);
+  }
+
+  QueueStats queue_stats() const override {
+    QueueStats stats;
+    stats.queue_depth = event_queue_.size();
+    stats.max_queue_depth = max_queue_depth_;
+    stats.dropped_events = dropped_event_count_;
+    stats.coalesced_events = coalesced_event_count_;
+    stats.batches = batch_count_;
+    return stats;
+  }
 
+  // May be called on any thread. Events from other threads are delivered on
+  // the platform thread in batches.
   void Success(const EncodableValue& event, bool cache_event = true) override {
+    std::vector<std::pair<EncodableValue, bool>> events;
+    {
+      std::lock_guard<std::mutex> lock(pending_->mutex);
+      pending_->events.emplace_back(event, cache_event);
+      if (!eina_main_loop_is()) {
+        if (!pending_->is_flush_scheduled) {
+          pending_->is_flush_scheduled = true;
+          ecore_main_loop_thread_safe_call_async(
+              &EventChannelProxyImpl::FlushPendingEvents,
+              new std::shared_ptr<PendingEvents>(pending_));
+        }
+        return;
+      }
+      // Deliver the event right away, after those queued before it, so that
+      // it reaches Dart before the result of the method call being handled.
+      events.swap(pending_->events);
+    }
+    DispatchEvents(std::move(events));
+  }
+
+  void SetBatchChannel(const std::string& event_type,
+                       const std::string& channel_name) override {
+    // The channel is kept once created because the messenger may still
+    // refer to its handler.
+    if (!event_type.empty() && !batch_channel_) {
+      batch_channel_ = std::make_unique<EventChannelProxyImpl>(
+          messenger_, channel_name, kUnbounded);
+    }
+    batch_event_type_ = event_type;
+  }
+
+ private:
+  // Events waiting to be marshalled to the platform thread. Shared with the
+  // pending flush, which may run after the proxy is destroyed.
+  struct PendingEvents {
+    std::mutex mutex;
+    EventChannelProxyImpl* proxy = nullptr;
+    std::vector<std::pair<EncodableValue, bool>> events;
+    bool is_flush_scheduled = false;
+  };
+
+  static void FlushPendingEvents(void* data) {
+    std::unique_ptr<std::shared_ptr<PendingEvents>> pending(
+        static_cast<std::shared_ptr<PendingEvents>*>(data));
+
+    std::vector<std::pair<EncodableValue, bool>> events;
+    EventChannelProxyImpl* proxy;
+    {
+      std::lock_guard<std::mutex> lock((*pending)->mutex);
+      (*pending)->is_flush_scheduled = false;
+      proxy = (*pending)->proxy;
+      events.swap((*pending)->events);
+    }
+    if (!proxy || events.empty()) {
+      return;
+    }
+    proxy->DispatchEvents(std::move(events));
+  }
+
+  void DispatchEvents(std::vector<std::pair<EncodableValue, bool>>&& events) {
+    batch_count_++;
+    EncodableList batch;
+    for (auto& [event, cache_event] : events) {
+      if (!batch_event_type_.empty() &&
+          EventType(event) == batch_event_type_) {
+        batch.push_back(std::move(event));
+        continue;
+      }
+      DispatchBatch(&batch);
+      Dispatch(std::move(event), cache_event);
+    }
+    DispatchBatch(&batch);
+  }
+
+  void DispatchBatch(EncodableList* batch) {
+    if (batch->empty()) {
+      return;
+    }
+    batch_channel_->Dispatch(EncodableValue(std::move(*batch)), true);
+    batch->clear();
+  }
+
+  void Dispatch(EncodableValue&& event, bool cache_event) {
     if (sink_) {
       sink_->Success(event);
-    } else {
-      if (cache_event) {
-        event_queue_.push_back(event);
+      return;
+    }
+    if (!cache_event) {
+      return;
+    }
+
+    std::string type = EventType(event);
+    if (kCoalescedEvents.count(type)) {
+      for (auto it = event_queue_.begin(); it != event_queue_.end(); ++it) {
+        if (EventType(*it) == type) {
+          event_queue_.erase(it);
+          coalesced_event_count_++;
+          break;
+        }
+      }
+    }
+    if (max_queued_events_ != kUnbounded &&
+        event_queue_.size() >= max_queued_events_) {
+      if (dropped_event_count_ == 0) {
+        LOG_WARN("%s: too many events queued, dropping the oldest.",
+                 channel_name_.c_str());
       }
+      event_queue_.pop_front();
+      dropped_event_count_++;
     }
+    event_queue_.push_back(std::move(event));
+    if (max_queued_events_ == kUnbounded &&
+        event_queue_.size() % kQueueDepthWarningStep == 0) {
+      LOG_WARN("%s: %zu events queued, is nobody listening?",
+               channel_name_.c_str(), event_queue_.size());
+    }
+    max_queue_depth_ = std::max(max_queue_depth_, event_queue_.size());
   }
 
- private:
+  BinaryMessenger* messenger_;
+  std::string channel_name_;
   std::unique_ptr<EventChannel> channel_;
   std::unique_ptr<EventSink> sink_;
-  std::list<EncodableValue> event_queue_;
+  std::deque<EncodableValue> event_queue_;
+  size_t max_queued_events_;
+  std::shared_ptr<PendingEvents> pending_;
+  size_t max_queue_depth_ = 0;
+  size_t dropped_event_count_ = 0;
+  size_t coalesced_event_count_ = 0;
+  size_t batch_count_ = 0;
+  // Only accessed on the platform thread.
+  std::string batch_event_type_;
+  std::unique_ptr<EventChannelProxyImpl> batch_channel_;
 };
 
 std::unique_ptr<EventChannelProxy> EventChannelProxy::Create(
-    BinaryMessenger* messenger, const std::string& channelName) {
-  return std::make_unique<EventChannelProxyImpl>(messenger, channelName);
+    BinaryMessenger* messenger, const std::string& channelName,
+    size_t max_queued_events) {
+  return std::make_unique<EventChannelProxyImpl>(messenger, channelName,
+                                                 max_queued_events);
 }
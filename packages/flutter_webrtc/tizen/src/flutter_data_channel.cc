@@ -12,13 +12,20 @@ namespace flutter_webrtc_plugin {
 FlutterRTCDataChannelObserver::FlutterRTCDataChannelObserver(
     scoped_refptr<RTCDataChannel> data_channel, BinaryMessenger* messenger,
     const std::string& channelName)
-    : event_channel_(EventChannelProxy::Create(messenger, channelName)),
+    : event_channel_(EventChannelProxy::Create(messenger, channelName,
+                                               EventChannelProxy::kUnbounded)),
       data_channel_(data_channel) {
   data_channel_->RegisterObserver(this);
 }
 
 FlutterRTCDataChannelObserver::~FlutterRTCDataChannelObserver() {}
 
+void FlutterRTCDataChannelObserver::SetBatched(
+    bool batched, const std::string& channel_name) {
+  event_channel_->SetBatchChannel(batched ? "dataChannelReceiveMessage" : "",
+                                  channel_name);
+}
+
 void FlutterDataChannel::CreateDataChannel(
     const std::string& peerConnectionId, const std::string& label,
     const EncodableMap& dataChannelDict, RTCPeerConnection* pc,
@@ -58,9 +65,7 @@ void FlutterDataChannel::CreateDataChannel(
       new FlutterRTCDataChannelObserver(data_channel, base_->messenger_,
                                         event_channel));
 
-  base_->lock();
-  base_->data_channel_observers_[uuid] = std::move(observer);
-  base_->unlock();
+  base_->AddDataChannelObserver(uuid, std::move(observer));
 
   EncodableMap params;
   params[EncodableValue("id")] = EncodableValue(init.id);
@@ -73,36 +78,55 @@ void FlutterDataChannel::CreateDataChannel(
 void FlutterDataChannel::DataChannelSend(
     RTCDataChannel* data_channel, const std::string& type,
     const EncodableValue& data, std::unique_ptr<MethodResultProxy> result) {
+  // Send directly from the decoded message without copying the payload.
   bool is_binary = type == "binary";
-  if (is_binary && TypeIs<std::vector<uint8_t>>(data)) {
-    std::vector<uint8_t> buffer = GetValue<std::vector<uint8_t>>(data);
-    data_channel->Send(buffer.data(), static_cast<uint32_t>(buffer.size()),
+  const auto* buffer = std::get_if<std::vector<uint8_t>>(&data);
+  const auto* str = std::get_if<std::string>(&data);
+  if (is_binary && buffer) {
+    data_channel->Send(buffer->data(), static_cast<uint32_t>(buffer->size()),
                        true);
+  } else if (str) {
+    data_channel->Send(reinterpret_cast<const uint8_t*>(str->data()),
+                       static_cast<uint32_t>(str->size()), false);
   } else {
-    std::string str = GetValue<std::string>(data);
-    data_channel->Send(reinterpret_cast<const uint8_t*>(str.c_str()),
-                       static_cast<uint32_t>(str.length()), false);
+    result->Error("dataChannelSendFailed",
+                  "dataChannelSend() data must be a string or bytes");
+    return;
   }
   result->Success();
 }
 
+void FlutterDataChannel::DataChannelSetBatched(
+    const std::string& data_channel_uuid, bool batched,
+    std::unique_ptr<MethodResultProxy> result) {
+  auto observer = base_->DataChannelObserverForId(data_channel_uuid);
+  if (!observer) {
+    result->Error("dataChannelSetBatchedFailed",
+                  "dataChannelSetBatched() data_channel is null");
+    return;
+  }
+  std::string channel_name =
+      "FlutterWebRTC/dataChannelMessages" + data_channel_uuid;
+  observer->SetBatched(batched, channel_name);
+  EncodableMap params;
+  params[EncodableValue("channel")] = EncodableValue(channel_name);
+  result->Success(EncodableValue(params));
+}
+
 void FlutterDataChannel::DataChannelClose(
     RTCDataChannel* data_channel, const std::string& data_channel_uuid,
     std::unique_ptr<MethodResultProxy> result) {
   data_channel->Close();
-  auto it = base_->data_channel_observers_.find(data_channel_uuid);
-  if (it != base_->data_channel_observers_.end())
-    base_->data_channel_observers_.erase(it);
+  base_->RemoveDataChannelObserverForId(data_channel_uuid);
   result->Success();
 }
 
-RTCDataChannel* FlutterDataChannel::DataChannelForId(const std::string& uuid) {
-  auto it = base_->data_channel_observers_.find(uuid);
+scoped_refptr<RTCDataChannel> FlutterDataChannel::DataChannelForId(
+    const std::string& uuid) {
+  auto observer = base_->DataChannelObserverForId(uuid);
 
-  if (it != base_->data_channel_observers_.end()) {
-    FlutterRTCDataChannelObserver* observer = it->second.get();
-    scoped_refptr<RTCDataChannel> data_channel = observer->data_channel();
-    return data_channel.get();
+  if (observer) {
+    return observer->data_channel();
   }
   return nullptr;
 }
@@ -132,17 +156,18 @@ void FlutterRTCDataChannelObserver::OnStateChange(RTCDataChannelState state) {
 
 void FlutterRTCDataChannelObserver::OnMessage(const char* buffer, int length,
                                               bool binary) {
+  // Copy the payload only once, directly into the value sent to Dart.
+  EncodableValue payload =
+      binary ? EncodableValue(std::vector<uint8_t>(buffer, buffer + length))
+             : EncodableValue(std::string(buffer, length));
+
   EncodableMap params;
   params[EncodableValue("event")] = EncodableValue("dataChannelReceiveMessage");
 
   params[EncodableValue("id")] = EncodableValue(data_channel_->id());
   params[EncodableValue("type")] = EncodableValue(binary ? "binary" : "text");
-  std::string str(buffer, length);
-  params[EncodableValue("data")] =
-      binary ? EncodableValue(std::vector<uint8_t>(str.begin(), str.end()))
-             : EncodableValue(str);
+  params[EncodableValue("data")] = std::move(payload);
 
-  auto data = EncodableValue(params);
-  event_channel_->Success(data);
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 }  // namespace flutter_webrtc_plugin
@@ -0,0 +1,204 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter_frame_capturer.h"
+
+#include <image_util.h>
+#include <tizen_error.h>
+
+#include <cstdlib>
+#include <utility>
+
+#include "log.h"
+#include "video_frame_converter.h"
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+// Fails the capture if the track delivers no frame within this time, e.g.
+// because it is muted.
+constexpr double kCaptureTimeoutSeconds = 5.0;
+
+constexpr int kJpegQuality = 90;
+
+// Rotates RGBA |pixels| clockwise by |rotation| so that the image is upright.
+std::vector<uint8_t> RotateRgba(std::vector<uint8_t> pixels, int* width,
+                                int* height,
+                                RTCVideoFrame::VideoRotation rotation) {
+  if (rotation == RTCVideoFrame::kVideoRotation_0) {
+    return pixels;
+  }
+  int src_width = *width;
+  int src_height = *height;
+  const auto* src = reinterpret_cast<const uint32_t*>(pixels.data());
+  std::vector<uint8_t> rotated(pixels.size());
+  auto* dst = reinterpret_cast<uint32_t*>(rotated.data());
+  if (rotation == RTCVideoFrame::kVideoRotation_180) {
+    size_t count = static_cast<size_t>(src_width) * src_height;
+    for (size_t i = 0; i < count; i++) {
+      dst[count - 1 - i] = src[i];
+    }
+    return rotated;
+  }
+
+  std::swap(*width, *height);
+  bool is_clockwise = rotation == RTCVideoFrame::kVideoRotation_90;
+  for (int y = 0; y < src_height; y++) {
+    for (int x = 0; x < src_width; x++) {
+      int dst_x = is_clockwise ? src_height - 1 - y : y;
+      int dst_y = is_clockwise ? x : src_width - 1 - x;
+      dst[static_cast<size_t>(dst_y) * src_height + dst_x] =
+          src[static_cast<size_t>(y) * src_width + x];
+    }
+  }
+  return rotated;
+}
+
+}  // namespace
+
+void FlutterFrameCapturer::Capture(scoped_refptr<RTCVideoTrack> track,
+                                   const std::string& path, Format format,
+                                   std::unique_ptr<MethodResultProxy> result) {
+  auto* capturer =
+      new FlutterFrameCapturer(track, path, format, std::move(result));
+  capturer->timeout_timer_ = ecore_timer_add(
+      kCaptureTimeoutSeconds, &FlutterFrameCapturer::OnTimeout, capturer);
+  track->AddRenderer(capturer);
+}
+
+FlutterFrameCapturer::FlutterFrameCapturer(
+    scoped_refptr<RTCVideoTrack> track, const std::string& path,
+    Format format, std::unique_ptr<MethodResultProxy> result)
+    : track_(track),
+      path_(path),
+      format_(format),
+      result_(std::move(result)) {}
+
+FlutterFrameCapturer::~FlutterFrameCapturer() {
+  if (timeout_timer_) {
+    ecore_timer_del(timeout_timer_);
+    timeout_timer_ = nullptr;
+  }
+}
+
+void FlutterFrameCapturer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
+  // Called on the frame delivery thread. Only the first frame is taken and
+  // the rest of the work is moved off this thread.
+  if (has_frame_.exchange(true)) {
+    return;
+  }
+  frame_ = frame;
+  ecore_main_loop_thread_safe_call_async(&FlutterFrameCapturer::OnFrameCaptured,
+                                         this);
+}
+
+void FlutterFrameCapturer::Fail(const std::string& message) {
+  result_->Error("captureFrame", message);
+  delete this;
+}
+
+void FlutterFrameCapturer::OnFrameCaptured(void* data) {
+  auto* self = static_cast<FlutterFrameCapturer*>(data);
+  self->track_->RemoveRenderer(self);
+  if (self->timeout_timer_) {
+    ecore_timer_del(self->timeout_timer_);
+    self->timeout_timer_ = nullptr;
+  }
+  if (!self->frame_->DataY() || !self->frame_->DataU() ||
+      !self->frame_->DataV()) {
+    self->Fail("captureFrame() the frame has no I420 planes");
+    return;
+  }
+  // The cancel callback also runs if the thread cannot be started.
+  ecore_thread_run(&FlutterFrameCapturer::OnEncode,
+                   &FlutterFrameCapturer::OnEncodeEnd,
+                   &FlutterFrameCapturer::OnEncodeEnd, self);
+}
+
+Eina_Bool FlutterFrameCapturer::OnTimeout(void* data) {
+  auto* self = static_cast<FlutterFrameCapturer*>(data);
+  self->timeout_timer_ = nullptr;
+  self->track_->RemoveRenderer(self);
+  if (self->has_frame_) {
+    // A frame arrived just in time and OnFrameCaptured is pending.
+    return ECORE_CALLBACK_CANCEL;
+  }
+  self->Fail("captureFrame() no frame received from the track");
+  return ECORE_CALLBACK_CANCEL;
+}
+
+void FlutterFrameCapturer::OnEncode(void* data, Ecore_Thread* thread) {
+  auto* self = static_cast<FlutterFrameCapturer*>(data);
+  RTCVideoFrame* frame = self->frame_.get();
+  int width = frame->width();
+  int height = frame->height();
+
+  std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+  ConvertI420ToRgba(frame->DataY(), frame->StrideY(), frame->DataU(),
+                    frame->StrideU(), frame->DataV(), frame->StrideV(), width,
+                    height, pixels.data(), width, height);
+  RTCVideoFrame::VideoRotation rotation = frame->rotation();
+  // Release the frame as early as possible.
+  self->frame_ = nullptr;
+  pixels = RotateRgba(std::move(pixels), &width, &height, rotation);
+
+  image_util_image_h image = nullptr;
+  int ret = image_util_create_image(width, height,
+                                    IMAGE_UTIL_COLORSPACE_RGBA8888,
+                                    pixels.data(), pixels.size(), &image);
+  if (ret != IMAGE_UTIL_ERROR_NONE) {
+    self->error_ = get_error_message(ret);
+    return;
+  }
+  image_util_encode_h encoder = nullptr;
+  ret = image_util_encode_create(
+      self->format_ == Format::kPng ? IMAGE_UTIL_PNG : IMAGE_UTIL_JPEG,
+      &encoder);
+  if (ret == IMAGE_UTIL_ERROR_NONE) {
+    if (self->format_ == Format::kJpeg) {
+      image_util_encode_set_quality(encoder, kJpegQuality);
+    }
+    if (!self->path_.empty()) {
+      ret = image_util_encode_run_to_file(encoder, image, self->path_.c_str());
+    } else {
+      unsigned char* buffer = nullptr;
+      size_t buffer_size = 0;
+      ret = image_util_encode_run_to_buffer(encoder, image, &buffer,
+                                            &buffer_size);
+      if (ret == IMAGE_UTIL_ERROR_NONE) {
+        self->encoded_.assign(buffer, buffer + buffer_size);
+        free(buffer);
+      }
+    }
+    image_util_encode_destroy(encoder);
+  }
+  if (ret == IMAGE_UTIL_ERROR_NONE) {
+    self->is_encoded_ = true;
+  } else {
+    self->error_ = get_error_message(ret);
+  }
+  image_util_destroy_image(image);
+}
+
+void FlutterFrameCapturer::OnEncodeEnd(void* data, Ecore_Thread* thread) {
+  auto* self = static_cast<FlutterFrameCapturer*>(data);
+  if (!self->is_encoded_) {
+    if (self->error_.empty()) {
+      self->Fail("captureFrame() encoding was cancelled");
+    } else {
+      LOG_ERROR("Failed to encode a frame: %s", self->error_.c_str());
+      self->Fail("captureFrame() " + self->error_);
+    }
+    return;
+  }
+  if (self->path_.empty()) {
+    self->result_->Success(EncodableValue(std::move(self->encoded_)));
+  } else {
+    self->result_->Success();
+  }
+  delete self;
+}
+
+}  // namespace flutter_webrtc_plugin
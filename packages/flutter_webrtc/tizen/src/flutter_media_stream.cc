@@ -58,7 +58,7 @@ void FlutterMediaStream::GetUserMedia(
     }
   }
 
-  base_->local_streams_[uuid] = stream;
+  base_->AddMediaStream(uuid, stream);
   result->Success(EncodableValue(params));
 }
 
@@ -170,7 +170,7 @@ void FlutterMediaStream::GetUserAudio(const EncodableMap& constraints,
     params[EncodableValue("audioTracks")] = EncodableValue(audioTracks);
     stream->AddTrack(track);
 
-    base_->local_tracks_[track->id().std_string()] = track;
+    base_->AddMediaTrack(track);
   }
 }
 
@@ -294,7 +294,7 @@ void FlutterMediaStream::GetUserVideo(const EncodableMap& constraints,
 
   stream->AddTrack(track);
 
-  base_->local_tracks_[track->id().std_string()] = track;
+  base_->AddMediaTrack(track);
 }
 
 void FlutterMediaStream::GetSources(std::unique_ptr<MethodResultProxy> result) {
@@ -396,7 +396,7 @@ void FlutterMediaStream::MediaStreamGetTracks(
 
     auto audio_tracks = stream->audio_tracks();
     for (auto track : audio_tracks.std_vector()) {
-      base_->local_tracks_[track->id().std_string()] = track;
+      base_->AddMediaTrack(track);
       EncodableMap info;
       info[EncodableValue("id")] = EncodableValue(track->id().std_string());
       info[EncodableValue("label")] = EncodableValue(track->id().std_string());
@@ -411,7 +411,7 @@ void FlutterMediaStream::MediaStreamGetTracks(
     EncodableList videoTracks;
     auto video_tracks = stream->video_tracks();
     for (auto track : video_tracks.std_vector()) {
-      base_->local_tracks_[track->id().std_string()] = track;
+      base_->AddMediaTrack(track);
       EncodableMap info;
       info[EncodableValue("id")] = EncodableValue(track->id().std_string());
       info[EncodableValue("label")] = EncodableValue(track->id().std_string());
@@ -445,13 +445,13 @@ void FlutterMediaStream::MediaStreamDispose(
 
   for (auto track : audio_tracks.std_vector()) {
     stream->RemoveTrack(track);
-    base_->local_tracks_.erase(track->id().std_string());
+    base_->RemoveMediaTrackForId(track->id().std_string());
   }
 
   vector<scoped_refptr<RTCVideoTrack>> video_tracks = stream->video_tracks();
   for (auto track : video_tracks.std_vector()) {
     stream->RemoveTrack(track);
-    base_->local_tracks_.erase(track->id().std_string());
+    base_->RemoveMediaTrackForId(track->id().std_string());
   }
 
   base_->RemoveStreamForId(stream_id);
@@ -467,7 +467,7 @@ void FlutterMediaStream::CreateLocalMediaStream(
   EncodableMap params;
   params[EncodableValue("streamId")] = EncodableValue(uuid);
 
-  base_->local_streams_[uuid] = stream;
+  base_->AddMediaStream(uuid, stream);
   result->Success(EncodableValue(params));
 }
 
@@ -483,8 +483,7 @@ void FlutterMediaStream::MediaStreamTrackSwitchCamera(
 
 void FlutterMediaStream::MediaStreamTrackDispose(
     const std::string& track_id, std::unique_ptr<MethodResultProxy> result) {
-  for (auto it : base_->local_streams_) {
-    auto stream = it.second;
+  for (auto stream : base_->LocalMediaStreams()) {
     auto audio_tracks = stream->audio_tracks();
     for (auto track : audio_tracks.std_vector()) {
       if (track->id().std_string() == track_id) {
@@ -5,8 +5,11 @@
 
 #include "flutter_peerconnection.h"
 
+#include <algorithm>
+
 #include "base/scoped_ref_ptr.h"
 #include "flutter_data_channel.h"
+#include "flutter_frame_capturer.h"
 #include "rtc_dtmf_sender.h"
 #include "rtc_rtp_parameters.h"
 
@@ -239,7 +242,7 @@ void FlutterPeerConnection::CreateRTCPeerConnection(
   std::string uuid = base_->GenerateUUID();
   scoped_refptr<RTCPeerConnection> pc =
       base_->factory_->Create(base_->configuration_, constraints);
-  base_->peerconnections_[uuid] = pc;
+  base_->AddPeerConnection(uuid, pc);
 
   std::string event_channel = "FlutterWebRTC/peerConnectionEvent" + uuid;
 
@@ -247,7 +250,7 @@ void FlutterPeerConnection::CreateRTCPeerConnection(
       new FlutterPeerConnectionObserver(base_, pc, base_->messenger_,
                                         event_channel, uuid));
 
-  base_->peerconnection_observers_[uuid] = std::move(observer);
+  base_->AddPeerConnectionObserver(uuid, std::move(observer));
 
   EncodableMap params;
   params[EncodableValue("peerConnectionId")] = EncodableValue(uuid);
@@ -264,11 +267,10 @@ void FlutterPeerConnection::RTCPeerConnectionClose(
 void FlutterPeerConnection::RTCPeerConnectionDispose(
     RTCPeerConnection* pc, const std::string& uuid,
     std::unique_ptr<MethodResultProxy> result) {
-  auto it = base_->peerconnection_observers_.find(uuid);
-  if (it != base_->peerconnection_observers_.end())
-    base_->peerconnection_observers_.erase(it);
-  auto it2 = base_->peerconnections_.find(uuid);
-  if (it2 != base_->peerconnections_.end()) base_->peerconnections_.erase(it2);
+  stats_streams_.erase(uuid);
+  sender_adaptations_.erase(uuid);
+  base_->RemovePeerConnectionObserversForId(uuid);
+  base_->RemovePeerConnectionForId(uuid);
   result->Success();
 }
 
@@ -377,6 +379,9 @@ FlutterPeerConnection::mapToRtpTransceiverInit(const EncodableMap& params) {
   for (EncodableValue value : sendEncodings) {
     encodings.push_back(mapToEncoding(GetValue<EncodableMap>(value)));
   }
+  if (encodings.empty()) {
+    encodings = simulcastEncodings(findInt(params, "simulcastLayers"));
+  }
   scoped_refptr<RTCRtpTransceiverInit> init =
       RTCRtpTransceiverInit::Create(dir, stream_ids, encodings);
   return init;
@@ -444,12 +449,41 @@ FlutterPeerConnection::mapToEncoding(const EncodableMap& params) {
 
   value = findEncodableValue(params, "scaleResolutionDownBy");
   if (!value.IsNull()) {
-    encoding->set_scale_resolution_down_by(GetValue<double>(value));
+    encoding->set_scale_resolution_down_by(toDouble(value, 1.0));
+  }
+
+  value = findEncodableValue(params, "scalabilityMode");
+  if (TypeIs<std::string>(value)) {
+    const std::string mode = GetValue<std::string>(value);
+    encoding->set_scalability_mode(mode.c_str());
   }
 
   return encoding;
 }
 
+std::vector<scoped_refptr<RTCRtpEncodingParameters>>
+FlutterPeerConnection::simulcastEncodings(int layers) {
+  // From the highest to the lowest resolution, each a quarter of the
+  // previous one in pixels.
+  static const char* kRids[] = {"f", "h", "q"};
+  std::vector<scoped_refptr<RTCRtpEncodingParameters>> encodings;
+  if (layers < 2) {
+    return encodings;
+  }
+  layers = std::min(layers, 3);
+  double scale = 1.0;
+  for (int i = 0; i < layers; i++) {
+    scoped_refptr<RTCRtpEncodingParameters> encoding =
+        RTCRtpEncodingParameters::Create();
+    encoding->set_active(true);
+    encoding->set_rid(kRids[i]);
+    encoding->set_scale_resolution_down_by(scale);
+    encodings.push_back(encoding);
+    scale *= 2;
+  }
+  return encodings;
+}
+
 RTCMediaType stringToMediaType(const std::string& mediaType) {
   RTCMediaType type = RTCMediaType::ANY;
   if (mediaType == "audio")
@@ -465,7 +499,7 @@ void FlutterPeerConnection::AddTransceiver(
     std::unique_ptr<MethodResultProxy> result) {
   std::shared_ptr<MethodResultProxy> result_ptr(result.release());
 
-  RTCMediaTrack* track = base_->MediaTrackForId(trackId);
+  scoped_refptr<RTCMediaTrack> track = base_->MediaTrackForId(trackId);
   RTCMediaType type = stringToMediaType(mediaType);
 
   if (0 < transceiverInit.size()) {
@@ -594,7 +628,12 @@ scoped_refptr<RTCRtpParameters> FlutterPeerConnection::updateRtpParameters(
       }
       value = findEncodableValue(map, "scaleResolutionDownBy");
       if (!value.IsNull()) {
-        param->set_scale_resolution_down_by(GetValue<int>(value));
+        param->set_scale_resolution_down_by(toDouble(value, 1.0));
+      }
+      value = findEncodableValue(map, "scalabilityMode");
+      if (TypeIs<std::string>(value)) {
+        const std::string mode = GetValue<std::string>(value);
+        param->set_scalability_mode(mode.c_str());
       }
 
       encoding++;
@@ -661,14 +700,29 @@ void FlutterPeerConnection::SetConfiguration(
   result_ptr->Success();
 }
 
+static bool EndsWith(const std::string& str, const std::string& suffix) {
+  return str.size() >= suffix.size() &&
+         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
 void FlutterPeerConnection::CaptureFrame(
-    RTCVideoTrack* track, std::string path,
+    RTCVideoTrack* track, std::string path, std::string format,
     std::unique_ptr<MethodResultProxy> result) {
-  std::shared_ptr<MethodResultProxy> result_ptr(result.release());
-
-  // TODO pc->CaptureFrame();
-
-  result_ptr->Success();
+  if (format.empty()) {
+    format = EndsWith(path, ".jpg") || EndsWith(path, ".jpeg") ? "jpeg" : "png";
+  }
+  FlutterFrameCapturer::Format capture_format;
+  if (format == "jpeg" || format == "jpg") {
+    capture_format = FlutterFrameCapturer::Format::kJpeg;
+  } else if (format == "png") {
+    capture_format = FlutterFrameCapturer::Format::kPng;
+  } else {
+    result->Error("captureFrame",
+                  "captureFrame() unsupported format: " + format);
+    return;
+  }
+  FlutterFrameCapturer::Capture(track, path, capture_format,
+                                std::move(result));
 }
 
 scoped_refptr<RTCRtpTransceiver> FlutterPeerConnection::getRtpTransceiverById(
@@ -777,6 +831,44 @@ EncodableMap statsToMap(const scoped_refptr<MediaRTCStats>& stats) {
   return report_map;
 }
 
+void FlutterPeerConnection::StartStatsStreaming(
+    RTCPeerConnection* pc, const std::string& uuid, double interval,
+    const std::vector<std::string>& fields,
+    std::unique_ptr<MethodResultProxy> result) {
+  // Replaces the existing stream of |pc| if any. The channel must be
+  // released before being registered again.
+  stats_streams_.erase(uuid);
+  stats_streams_[uuid] = std::make_unique<FlutterStatsStream>(
+      pc, base_->messenger_, "FlutterWebRTC/peerConnectionStats" + uuid,
+      interval, fields);
+  result->Success();
+}
+
+void FlutterPeerConnection::StopStatsStreaming(
+    const std::string& uuid, std::unique_ptr<MethodResultProxy> result) {
+  stats_streams_.erase(uuid);
+  result->Success();
+}
+
+void FlutterPeerConnection::StartSenderAdaptation(
+    RTCPeerConnection* pc, const std::string& uuid,
+    const FlutterSenderAdaptation::Config& config,
+    std::unique_ptr<MethodResultProxy> result) {
+  // Restores the senders before the new instance records their original
+  // parameters.
+  sender_adaptations_.erase(uuid);
+  sender_adaptations_[uuid] = std::make_unique<FlutterSenderAdaptation>(
+      pc, base_->messenger_, "FlutterWebRTC/peerConnectionAdaptation" + uuid,
+      config);
+  result->Success();
+}
+
+void FlutterPeerConnection::StopSenderAdaptation(
+    const std::string& uuid, std::unique_ptr<MethodResultProxy> result) {
+  sender_adaptations_.erase(uuid);
+  result->Success();
+}
+
 void FlutterPeerConnection::GetStats(
     const std::string& track_id, RTCPeerConnection* pc,
     std::unique_ptr<MethodResultProxy> result) {
@@ -932,7 +1024,8 @@ FlutterPeerConnectionObserver::FlutterPeerConnectionObserver(
     FlutterWebRTCBase* base, scoped_refptr<RTCPeerConnection> peerconnection,
     BinaryMessenger* messenger, const std::string& channel_name,
     std::string& peerConnectionId)
-    : event_channel_(EventChannelProxy::Create(messenger, channel_name)),
+    : event_channel_(EventChannelProxy::Create(messenger, channel_name,
+                                               EventChannelProxy::kUnbounded)),
       peerconnection_(peerconnection),
       base_(base),
       id_(peerConnectionId) {
@@ -1095,7 +1188,10 @@ void FlutterPeerConnectionObserver::OnAddStream(
 
     videoTracks.push_back(EncodableValue(videoTrack));
   }
-  remote_streams_[streamId] = scoped_refptr<RTCMediaStream>(stream);
+  {
+    std::lock_guard<std::mutex> lock(remote_streams_mutex_);
+    remote_streams_[streamId] = scoped_refptr<RTCMediaStream>(stream);
+  }
   params[EncodableValue("videoTracks")] = EncodableValue(videoTracks);
 
   event_channel_->Success(EncodableValue(params));
@@ -1209,9 +1305,7 @@ void FlutterPeerConnectionObserver::OnDataChannel(
       new FlutterRTCDataChannelObserver(data_channel, base_->messenger_,
                                         event_channel));
 
-  base_->lock();
-  base_->data_channel_observers_[channel_uuid] = std::move(observer);
-  base_->unlock();
+  base_->AddDataChannelObserver(channel_uuid, std::move(observer));
 
   EncodableMap params;
   params[EncodableValue("event")] = "didOpenDataChannel";
@@ -1230,6 +1324,7 @@ void FlutterPeerConnectionObserver::OnRenegotiationNeeded() {
 
 scoped_refptr<RTCMediaStream> FlutterPeerConnectionObserver::MediaStreamForId(
     const std::string& id) {
+  std::lock_guard<std::mutex> lock(remote_streams_mutex_);
   auto it = remote_streams_.find(id);
   if (it != remote_streams_.end()) return (*it).second;
   return nullptr;
@@ -1237,6 +1332,7 @@ scoped_refptr<RTCMediaStream> FlutterPeerConnectionObserver::MediaStreamForId(
 
 scoped_refptr<RTCMediaTrack> FlutterPeerConnectionObserver::MediaTrackForId(
     const std::string& id) {
+  std::lock_guard<std::mutex> lock(remote_streams_mutex_);
   for (auto it = remote_streams_.begin(); it != remote_streams_.end(); it++) {
     auto remoteStream = (*it).second;
     auto audio_tracks = remoteStream->audio_tracks();
@@ -1256,6 +1352,7 @@ scoped_refptr<RTCMediaTrack> FlutterPeerConnectionObserver::MediaTrackForId(
 }
 
 void FlutterPeerConnectionObserver::RemoveStreamForId(const std::string& id) {
+  std::lock_guard<std::mutex> lock(remote_streams_mutex_);
   auto it = remote_streams_.find(id);
   if (it != remote_streams_.end()) remote_streams_.erase(it);
 }
@@ -0,0 +1,222 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter_sender_adaptation.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include "log.h"
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+struct AdaptationStep {
+  // Multiplied with the original value of each encoding.
+  double scale_resolution_down_by;
+  // 0 means the original frame rate.
+  double max_framerate;
+};
+
+// Frame rate is reduced before resolution because it saves encoding time
+// with less visible loss.
+constexpr AdaptationStep kSteps[] = {
+    {1.0, 0.0}, {1.0, 20.0}, {1.5, 20.0}, {2.0, 15.0}, {3.0, 15.0}, {4.0, 10.0},
+};
+
+constexpr int kMaxLevel = static_cast<int>(std::size(kSteps)) - 1;
+
+// Only recent level changes are of interest to a late listener.
+constexpr size_t kMaxQueuedEvents = 32;
+
+}  // namespace
+
+FlutterSenderAdaptation::FlutterSenderAdaptation(
+    scoped_refptr<RTCPeerConnection> pc, BinaryMessenger* messenger,
+    const std::string& channel_name, const Config& config)
+    : pc_(pc),
+      event_channel_(
+          EventChannelProxy::Create(messenger, channel_name, kMaxQueuedEvents)),
+      config_(config) {
+  SnapshotEncodings();
+  // The first sample only serves as the baseline of the next one.
+  double usage;
+  SampleCpuUsage(&usage);
+  timer_ = ecore_timer_add(config_.interval,
+                           &FlutterSenderAdaptation::OnInterval, this);
+}
+
+FlutterSenderAdaptation::~FlutterSenderAdaptation() {
+  if (timer_) {
+    ecore_timer_del(timer_);
+    timer_ = nullptr;
+  }
+  if (level_ != 0) {
+    level_ = 0;
+    ApplyLevel();
+  }
+}
+
+Eina_Bool FlutterSenderAdaptation::OnInterval(void* data) {
+  auto* self = static_cast<FlutterSenderAdaptation*>(data);
+  double usage;
+  if (!self->SampleCpuUsage(&usage)) {
+    return ECORE_CALLBACK_RENEW;
+  }
+
+  if (usage >= self->config_.high_cpu_usage) {
+    self->recovery_count_ = 0;
+    if (self->level_ < kMaxLevel) {
+      self->SetLevel(self->level_ + 1, usage);
+    }
+  } else if (usage < self->config_.low_cpu_usage) {
+    if (self->level_ > 0 &&
+        ++self->recovery_count_ >= self->config_.recovery_samples) {
+      self->recovery_count_ = 0;
+      self->SetLevel(self->level_ - 1, usage);
+    }
+  } else {
+    self->recovery_count_ = 0;
+  }
+  return ECORE_CALLBACK_RENEW;
+}
+
+bool FlutterSenderAdaptation::SampleCpuUsage(double* usage) {
+  std::ifstream file("/proc/stat");
+  std::string cpu;
+  uint64_t user = 0, nice = 0, system = 0, idle = 0, iowait = 0, irq = 0,
+           softirq = 0, steal = 0;
+  if (!(file >> cpu >> user >> nice >> system >> idle >> iowait >> irq >>
+        softirq >> steal) ||
+      cpu != "cpu") {
+    LOG_ERROR("Failed to read /proc/stat.");
+    return false;
+  }
+
+  uint64_t busy = user + nice + system + irq + softirq + steal;
+  uint64_t total = busy + idle + iowait;
+  bool has_previous = previous_total_ > 0 && total > previous_total_;
+  if (has_previous) {
+    *usage = 100.0 * (busy - previous_busy_) / (total - previous_total_);
+  }
+  previous_busy_ = busy;
+  previous_total_ = total;
+  return has_previous;
+}
+
+void FlutterSenderAdaptation::SetLevel(int level, double cpu_usage) {
+  bool is_overused = level > level_;
+  level_ = level;
+  EncodableList senders = ApplyLevel();
+  LOG_INFO("Sender adaptation level %d (CPU usage %.1f%%).", level_,
+           cpu_usage);
+
+  EncodableMap event;
+  event[EncodableValue("event")] = "senderAdaptationChanged";
+  event[EncodableValue("level")] = EncodableValue(level_);
+  event[EncodableValue("maxLevel")] = EncodableValue(kMaxLevel);
+  event[EncodableValue("cpuUsage")] = EncodableValue(cpu_usage);
+  event[EncodableValue("reason")] =
+      EncodableValue(is_overused ? "cpuOveruse" : "cpuRecovered");
+  event[EncodableValue("senders")] = EncodableValue(senders);
+  event_channel_->Success(EncodableValue(event));
+}
+
+FlutterSenderAdaptation::Encoding FlutterSenderAdaptation::ReadEncoding(
+    RTCRtpEncodingParameters* encoding) {
+  Encoding original;
+  original.scale_resolution_down_by = encoding->scale_resolution_down_by();
+  original.max_framerate = encoding->max_framerate();
+  return original;
+}
+
+void FlutterSenderAdaptation::SnapshotEncodings() {
+  for (auto sender : pc_->senders().std_vector()) {
+    if (sender->media_type() != RTCMediaType::VIDEO) {
+      continue;
+    }
+    std::vector<Encoding>& originals =
+        original_encodings_[sender->id().std_string()];
+    originals.clear();
+    for (auto encoding : sender->parameters()->encodings().std_vector()) {
+      originals.push_back(ReadEncoding(encoding.get()));
+    }
+  }
+}
+
+EncodableList FlutterSenderAdaptation::ApplyLevel() {
+  const AdaptationStep& step = kSteps[level_];
+  EncodableList senders;
+  for (auto sender : pc_->senders().std_vector()) {
+    if (sender->media_type() != RTCMediaType::VIDEO) {
+      continue;
+    }
+    std::string sender_id = sender->id().std_string();
+    scoped_refptr<RTCRtpParameters> parameters = sender->parameters();
+    auto encodings = parameters->encodings().std_vector();
+
+    std::vector<Encoding>& originals = original_encodings_[sender_id];
+    if (originals.size() != encodings.size()) {
+      // A new sender, or the app replaced the encodings.
+      originals.clear();
+      for (auto encoding : encodings) {
+        originals.push_back(ReadEncoding(encoding.get()));
+      }
+    }
+
+    EncodableList encoding_list;
+    for (size_t i = 0; i < encodings.size(); i++) {
+      Encoding& original = originals[i];
+      if (original.is_applied &&
+          (encodings[i]->scale_resolution_down_by() !=
+               original.applied_scale_resolution_down_by ||
+           encodings[i]->max_framerate() != original.applied_max_framerate)) {
+        // Set by the app with rtpSenderSetParameters since the last change.
+        original = ReadEncoding(encodings[i].get());
+      }
+
+      double scale = original.scale_resolution_down_by;
+      double framerate = original.max_framerate;
+      if (level_ > 0) {
+        scale = std::max(scale, 1.0) * step.scale_resolution_down_by;
+        double source_framerate = original.max_framerate > 0
+                                      ? original.max_framerate
+                                      : config_.max_framerate;
+        if (step.max_framerate > 0 && step.max_framerate < source_framerate) {
+          framerate = step.max_framerate;
+        }
+      }
+      encodings[i]->set_scale_resolution_down_by(scale);
+      encodings[i]->set_max_framerate(framerate);
+      original.is_applied = true;
+      original.applied_scale_resolution_down_by = scale;
+      original.applied_max_framerate = framerate;
+
+      EncodableMap encoding;
+      encoding[EncodableValue("rid")] =
+          EncodableValue(encodings[i]->rid().std_string());
+      encoding[EncodableValue("scaleResolutionDownBy")] = EncodableValue(scale);
+      encoding[EncodableValue("maxFramerate")] = EncodableValue(framerate);
+      encoding_list.push_back(EncodableValue(encoding));
+    }
+    if (!sender->set_parameters(parameters)) {
+      LOG_WARN("Failed to set the parameters of sender %s.",
+               sender_id.c_str());
+      for (Encoding& original : originals) {
+        original.is_applied = false;
+      }
+      continue;
+    }
+
+    EncodableMap info;
+    info[EncodableValue("rtpSenderId")] = EncodableValue(sender_id);
+    info[EncodableValue("encodings")] = EncodableValue(encoding_list);
+    senders.push_back(EncodableValue(info));
+  }
+  return senders;
+}
+
+}  // namespace flutter_webrtc_plugin
@@ -0,0 +1,246 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter_stats_stream.h"
+
+#include <algorithm>
+#include <set>
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+// Each report supersedes the previous ones, so only the latest few are kept
+// for a late listener.
+constexpr size_t kMaxQueuedEvents = 4;
+
+double NumberValue(const scoped_refptr<RTCStatsMember>& member) {
+  switch (member->GetType()) {
+    case RTCStatsMember::Type::kInt32:
+      return member->ValueInt32();
+    case RTCStatsMember::Type::kUint32:
+      return member->ValueUint32();
+    case RTCStatsMember::Type::kInt64:
+      return static_cast<double>(member->ValueInt64());
+    case RTCStatsMember::Type::kUint64:
+      return static_cast<double>(member->ValueUint64());
+    case RTCStatsMember::Type::kDouble:
+      return member->ValueDouble();
+    default:
+      return 0.0;
+  }
+}
+
+// The members of a report that derived values are computed from.
+struct ReportValues {
+  std::string kind;
+  std::string state;
+  bool nominated = false;
+  std::map<std::string, double> numbers;
+
+  bool Has(const std::string& name) const { return numbers.count(name) > 0; }
+  double Get(const std::string& name) const {
+    auto it = numbers.find(name);
+    return it != numbers.end() ? it->second : 0.0;
+  }
+};
+
+ReportValues ReadReport(const scoped_refptr<MediaRTCStats>& report) {
+  static const std::set<std::string> kNumberMembers = {
+      "bytesReceived",    "bytesSent",
+      "packetsReceived",  "packetsSent",
+      "packetsLost",      "jitter",
+      "framesPerSecond",  "roundTripTime",
+      "fractionLost",     "currentRoundTripTime",
+      "availableOutgoingBitrate"};
+  ReportValues values;
+  for (const auto& member : report->Members().std_vector()) {
+    if (!member->IsDefined()) {
+      continue;
+    }
+    std::string name = member->GetName().std_string();
+    if (name == "kind" || name == "mediaType") {
+      values.kind = member->ValueString().std_string();
+    } else if (name == "state") {
+      values.state = member->ValueString().std_string();
+    } else if (name == "nominated") {
+      values.nominated = member->ValueBool();
+    } else if (kNumberMembers.count(name)) {
+      values.numbers[name] = NumberValue(member);
+    }
+  }
+  return values;
+}
+
+}  // namespace
+
+FlutterStatsStream::FlutterStatsStream(scoped_refptr<RTCPeerConnection> pc,
+                                       BinaryMessenger* messenger,
+                                       const std::string& channel_name,
+                                       double interval,
+                                       const std::vector<std::string>& fields)
+    : pc_(pc),
+      event_channel_(
+          EventChannelProxy::Create(messenger, channel_name, kMaxQueuedEvents)),
+      state_(std::make_shared<State>()) {
+  state_->fields = fields;
+  state_->event_channel = event_channel_.get();
+  timer_ = ecore_timer_add(interval, &FlutterStatsStream::OnInterval, this);
+}
+
+FlutterStatsStream::~FlutterStatsStream() {
+  if (timer_) {
+    ecore_timer_del(timer_);
+    timer_ = nullptr;
+  }
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->is_active = false;
+  state_->event_channel = nullptr;
+}
+
+Eina_Bool FlutterStatsStream::OnInterval(void* data) {
+  auto* self = static_cast<FlutterStatsStream*>(data);
+  {
+    std::lock_guard<std::mutex> lock(self->state_->mutex);
+    if (self->state_->is_collecting) {
+      // The previous collection has not completed yet.
+      return ECORE_CALLBACK_RENEW;
+    }
+    self->state_->is_collecting = true;
+  }
+
+  std::shared_ptr<State> state = self->state_;
+  self->pc_->GetStats(
+      [state](const vector<scoped_refptr<MediaRTCStats>> reports) {
+        // Runs on the signaling thread.
+        EncodableValue event = Summarize(state.get(), reports);
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->is_collecting = false;
+        if (state->is_active) {
+          // The proxy marshals the event to the platform thread. Reports are
+          // not worth keeping until someone listens.
+          state->event_channel->Success(event, false);
+        }
+      },
+      [state](const char* error) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->is_collecting = false;
+      });
+  return ECORE_CALLBACK_RENEW;
+}
+
+EncodableValue FlutterStatsStream::Summarize(
+    State* state, const vector<scoped_refptr<MediaRTCStats>>& reports) {
+  // |fields| is never modified after construction.
+  const std::vector<std::string>& fields = state->fields;
+  auto is_selected = [&fields](const std::string& field) {
+    return fields.empty() ||
+           std::find(fields.begin(), fields.end(), field) != fields.end();
+  };
+
+  std::map<std::string, Sample> samples;
+  std::map<std::string, Sample> previous_samples;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    previous_samples = state->previous_samples;
+  }
+
+  EncodableList entries;
+  for (const auto& report : reports.std_vector()) {
+    std::string type = report->type().std_string();
+    bool is_inbound = type == "inbound-rtp";
+    bool is_outbound = type == "outbound-rtp";
+    bool is_remote_inbound = type == "remote-inbound-rtp";
+    bool is_candidate_pair = type == "candidate-pair";
+    if (!is_inbound && !is_outbound && !is_remote_inbound &&
+        !is_candidate_pair) {
+      continue;
+    }
+
+    std::string id = report->id().std_string();
+    ReportValues values = ReadReport(report);
+    if (is_candidate_pair &&
+        (!values.nominated || values.state != "succeeded")) {
+      continue;
+    }
+
+    EncodableMap entry;
+    entry[EncodableValue("id")] = EncodableValue(id);
+    entry[EncodableValue("type")] = EncodableValue(type);
+    if (!values.kind.empty()) {
+      entry[EncodableValue("kind")] = EncodableValue(values.kind);
+    }
+
+    if (is_inbound || is_outbound) {
+      Sample sample;
+      sample.timestamp_us = report->timestamp_us();
+      sample.bytes = static_cast<int64_t>(
+          values.Get(is_inbound ? "bytesReceived" : "bytesSent"));
+      sample.packets = static_cast<int64_t>(
+          values.Get(is_inbound ? "packetsReceived" : "packetsSent"));
+      sample.packets_lost = static_cast<int64_t>(values.Get("packetsLost"));
+      samples[id] = sample;
+
+      auto previous = previous_samples.find(id);
+      if (previous != previous_samples.end() &&
+          sample.timestamp_us > previous->second.timestamp_us) {
+        double seconds =
+            (sample.timestamp_us - previous->second.timestamp_us) / 1e6;
+        if (is_selected("bitrate")) {
+          // In kbps.
+          entry[EncodableValue("bitrate")] = EncodableValue(
+              (sample.bytes - previous->second.bytes) * 8 / seconds / 1000);
+        }
+        int64_t lost = sample.packets_lost - previous->second.packets_lost;
+        int64_t packets = sample.packets - previous->second.packets;
+        if (is_inbound && is_selected("packetLoss") && lost + packets > 0) {
+          entry[EncodableValue("packetLoss")] =
+              EncodableValue(std::max<int64_t>(lost, 0) /
+                             static_cast<double>(lost + packets));
+        }
+      }
+    }
+    if (is_remote_inbound && values.Has("fractionLost") &&
+        is_selected("packetLoss")) {
+      entry[EncodableValue("packetLoss")] =
+          EncodableValue(values.Get("fractionLost"));
+    }
+    if (values.Has("jitter") && is_selected("jitter")) {
+      // In milliseconds.
+      entry[EncodableValue("jitter")] =
+          EncodableValue(values.Get("jitter") * 1000);
+    }
+    if (values.Has("framesPerSecond") && is_selected("framesPerSecond")) {
+      entry[EncodableValue("framesPerSecond")] =
+          EncodableValue(values.Get("framesPerSecond"));
+    }
+    const char* rtt_name =
+        is_candidate_pair ? "currentRoundTripTime" : "roundTripTime";
+    if (values.Has(rtt_name) && is_selected("roundTripTime")) {
+      // In milliseconds.
+      entry[EncodableValue("roundTripTime")] =
+          EncodableValue(values.Get(rtt_name) * 1000);
+    }
+    if (values.Has("availableOutgoingBitrate") &&
+        is_selected("availableOutgoingBitrate")) {
+      // In kbps.
+      entry[EncodableValue("availableOutgoingBitrate")] =
+          EncodableValue(values.Get("availableOutgoingBitrate") / 1000);
+    }
+    entries.emplace_back(std::move(entry));
+  }
+
+  {
+    // Samples of streams that are gone are dropped here.
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->previous_samples = std::move(samples);
+  }
+
+  EncodableMap params;
+  params[EncodableValue("event")] = EncodableValue("statsReport");
+  params[EncodableValue("reports")] = EncodableValue(std::move(entries));
+  return EncodableValue(std::move(params));
+}
+
+}  // namespace flutter_webrtc_plugin
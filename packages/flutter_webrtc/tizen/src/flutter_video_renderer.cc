@@ -5,48 +5,154 @@
 
 #include "flutter_video_renderer.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "log.h"
+#include "video_frame_converter.h"
+
 namespace flutter_webrtc_plugin {
 
+namespace {
+
+// One surface being written, one pending, one displayed and one that the
+// engine may still be reading.
+constexpr size_t kGpuSurfacePoolSize = 4;
+
+// Size and rotation events are coalesced, so only a few events are pending
+// at any time.
+constexpr size_t kMaxQueuedEvents = 16;
+
+}  // namespace
+
 FlutterVideoRenderer::FlutterVideoRenderer(TextureRegistrar* registrar,
-                                           BinaryMessenger* messenger)
+                                           BinaryMessenger* messenger,
+                                           bool use_gpu_surface)
     : registrar_(registrar) {
-  texture_ =
-      std::make_unique<flutter::TextureVariant>(flutter::PixelBufferTexture(
-          [this](size_t width,
-                 size_t height) -> const FlutterDesktopPixelBuffer* {
-            return this->CopyPixelBuffer(width, height);
-          }));
+  if (use_gpu_surface && !VideoBufferPool::IsSupported()) {
+    LOG_WARN("NV12 tbm surfaces are not supported, using pixel buffers.");
+    use_gpu_surface = false;
+  }
+  if (use_gpu_surface) {
+    buffer_pool_ = std::make_unique<VideoBufferPool>(kGpuSurfacePoolSize);
+    texture_ =
+        std::make_unique<flutter::TextureVariant>(flutter::GpuSurfaceTexture(
+            kFlutterDesktopGpuSurfaceTypeNone,
+            [this](size_t width, size_t height)
+                -> const FlutterDesktopGpuSurfaceDescriptor* {
+              return this->ObtainGpuSurface(width, height);
+            }));
+  } else {
+    texture_ =
+        std::make_unique<flutter::TextureVariant>(flutter::PixelBufferTexture(
+            [this](size_t width,
+                   size_t height) -> const FlutterDesktopPixelBuffer* {
+              return this->CopyPixelBuffer(width, height);
+            }));
+  }
 
   texture_id_ = registrar_->RegisterTexture(texture_.get());
 
   std::string channel_name =
       "FlutterWebRTC/Texture" + std::to_string(texture_id_);
-  event_channel_ = EventChannelProxy::Create(messenger, channel_name);
+  event_channel_ =
+      EventChannelProxy::Create(messenger, channel_name, kMaxQueuedEvents);
 }
 
 const FlutterDesktopPixelBuffer* FlutterVideoRenderer::CopyPixelBuffer(
     size_t width, size_t height) const {
-  mutex_.lock();
-  if (pixel_buffer_.get() && frame_.get()) {
-    if (pixel_buffer_->width != frame_->width() ||
-        pixel_buffer_->height != frame_->height()) {
-      size_t buffer_size =
-          (size_t(frame_->width()) * size_t(frame_->height())) * (32 >> 3);
-      rgb_buffer_.reset(new uint8_t[buffer_size]);
-      pixel_buffer_->width = frame_->width();
-      pixel_buffer_->height = frame_->height();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (has_pending_frame_) {
+    std::swap(pending_index_, display_index_);
+    has_pending_frame_ = false;
+  }
+  const FrameBuffer& buffer = frame_buffers_[display_index_];
+  if (buffer.data.empty()) {
+    return nullptr;
+  }
+  pixel_buffer_.buffer = buffer.data.data();
+  pixel_buffer_.width = buffer.width;
+  pixel_buffer_.height = buffer.height;
+  return &pixel_buffer_;
+}
+
+const FlutterDesktopGpuSurfaceDescriptor*
+FlutterVideoRenderer::ObtainGpuSurface(size_t width, size_t height) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (has_pending_frame_) {
+    if (display_surface_) {
+      buffer_pool_->Release(display_surface_);
+    }
+    display_surface_ = pending_surface_;
+    pending_surface_ = nullptr;
+    has_pending_frame_ = false;
+  }
+  if (!display_surface_) {
+    return nullptr;
+  }
+  display_surface_->MarkHeldByEngine();
+  return display_surface_->GpuSurface();
+}
+
+bool FlutterVideoRenderer::WriteGpuSurface(
+    const scoped_refptr<RTCVideoFrame>& frame) {
+  if (!frame->DataY() || !frame->DataU() || !frame->DataV()) {
+    return false;
+  }
+  VideoBufferUnit* buffer = buffer_pool_->GetAvailableBuffer();
+  if (!buffer) {
+    return false;
+  }
+  if (!buffer->Write(frame.get())) {
+    buffer_pool_->Release(buffer);
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_surface_ = buffer;
+  has_pending_frame_ = true;
+  return true;
+}
+
+void FlutterVideoRenderer::ConvertFrame(
+    const scoped_refptr<RTCVideoFrame>& frame) {
+  size_t frame_width = frame->width();
+  size_t frame_height = frame->height();
+  bool has_planes = frame->DataY() && frame->DataU() && frame->DataV();
+
+  // Convert only as many pixels as are displayed, keeping the aspect ratio,
+  // so that small tiles do not pay for full resolution conversion. Frames
+  // without I420 planes can only be converted at full size.
+  size_t width = frame_width;
+  size_t height = frame_height;
+  size_t target_width = target_width_;
+  size_t target_height = target_height_;
+  if (has_planes && target_width > 0 && target_height > 0 &&
+      (target_width < frame_width || target_height < frame_height)) {
+    if (target_width * frame_height < target_height * frame_width) {
+      width = target_width;
+      height = std::max<size_t>(1, frame_height * width / frame_width);
+    } else {
+      height = target_height;
+      width = std::max<size_t>(1, frame_width * height / frame_height);
     }
+  }
 
-    frame_->ConvertToARGB(RTCVideoFrame::Type::kABGR, rgb_buffer_.get(), 0,
-                          (int)pixel_buffer_->width,
-                          (int)pixel_buffer_->height);
+  FrameBuffer& buffer = frame_buffers_[write_index_];
+  if (buffer.width != width || buffer.height != height) {
+    buffer.data.resize(width * height * (32 >> 3));
+    buffer.width = width;
+    buffer.height = height;
+  }
 
-    pixel_buffer_->buffer = rgb_buffer_.get();
-    mutex_.unlock();
-    return pixel_buffer_.get();
+  if (has_planes) {
+    ConvertI420ToRgba(frame->DataY(), frame->StrideY(), frame->DataU(),
+                      frame->StrideU(), frame->DataV(), frame->StrideV(),
+                      (int)frame_width, (int)frame_height, buffer.data.data(),
+                      (int)width, (int)height);
+  } else {
+    frame->ConvertToARGB(RTCVideoFrame::Type::kABGR, buffer.data.data(), 0,
+                         (int)width, (int)height);
   }
-  mutex_.unlock();
-  return nullptr;
 }
 
 void FlutterVideoRenderer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
@@ -55,9 +161,6 @@ void FlutterVideoRenderer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
     params[EncodableValue("event")] = "didFirstFrameRendered";
     params[EncodableValue("id")] = EncodableValue(texture_id_);
     event_channel_->Success(EncodableValue(params));
-    pixel_buffer_.reset(new FlutterDesktopPixelBuffer());
-    pixel_buffer_->width = 0;
-    pixel_buffer_->height = 0;
     first_frame_rendered = true;
   }
   if (rotation_ != frame->rotation()) {
@@ -80,20 +183,120 @@ void FlutterVideoRenderer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
 
     last_frame_size_ = {(size_t)frame->width(), (size_t)frame->height()};
   }
-  mutex_.lock();
-  frame_ = frame;
-  mutex_.unlock();
+  if (is_paused_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latest_frame_ = frame;
+    return;
+  }
+  int64_t interval_us = min_frame_interval_us_;
+  if (interval_us > 0) {
+    // Frames arriving slightly early are accepted so that jitter does not
+    // halve the frame rate when it is a divisor of the source rate.
+    auto interval = std::chrono::microseconds(interval_us);
+    auto now = std::chrono::steady_clock::now();
+    if (now + interval / 4 < next_frame_time_) {
+      throttled_frame_count_++;
+      return;
+    }
+    if (now > next_frame_time_ + interval) {
+      next_frame_time_ = now + interval;
+    } else {
+      next_frame_time_ += interval;
+    }
+  }
+  PresentFrame(frame);
+}
+
+void FlutterVideoRenderer::PresentFrame(
+    const scoped_refptr<RTCVideoFrame>& frame) {
+  {
+    // The previous frame has not been displayed yet, which means frames
+    // arrive faster than they are rendered. Drop this one before paying for
+    // the conversion.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_pending_frame_) {
+      dropped_frame_count_++;
+      return;
+    }
+  }
+  if (buffer_pool_) {
+    if (!WriteGpuSurface(frame)) {
+      dropped_frame_count_++;
+      return;
+    }
+  } else {
+    ConvertFrame(frame);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(write_index_, pending_index_);
+    has_pending_frame_ = true;
+  }
   registrar_->MarkTextureFrameAvailable(texture_id_);
 }
 
 void FlutterVideoRenderer::SetVideoTrack(scoped_refptr<RTCVideoTrack> track) {
   if (track_ != track) {
-    if (track_) track_->RemoveRenderer(this);
+    if (track_) {
+      if (!is_detached_) track_->RemoveRenderer(this);
+      LOG_DEBUG("Frames dropped before conversion: %zu, throttled: %zu",
+                dropped_frame_count_, throttled_frame_count_);
+      dropped_frame_count_ = 0;
+      throttled_frame_count_ = 0;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      latest_frame_ = nullptr;
+    }
     track_ = track;
     last_frame_size_ = {0, 0};
     first_frame_rendered = false;
-    if (track_) track_->AddRenderer(this);
+    if (track_ && !is_detached_) track_->AddRenderer(this);
+  }
+}
+
+void FlutterVideoRenderer::SetPaused(bool paused, bool keep_latest_frame) {
+  if (paused) {
+    // Also switches the mode if already paused.
+    if (!keep_latest_frame && !is_detached_) {
+      if (track_) track_->RemoveRenderer(this);
+      is_detached_ = true;
+      std::lock_guard<std::mutex> lock(mutex_);
+      latest_frame_ = nullptr;
+    } else if (keep_latest_frame && is_detached_) {
+      is_detached_ = false;
+      if (track_) track_->AddRenderer(this);
+    }
+    is_paused_ = true;
+    return;
+  }
+  if (!is_paused_) {
+    return;
   }
+
+  if (track_ && !is_detached_) {
+    // Removing the renderer waits for the frame being delivered, if any, so
+    // that the kept frame can be presented on this thread.
+    track_->RemoveRenderer(this);
+  }
+  is_detached_ = false;
+  is_paused_ = false;
+  scoped_refptr<RTCVideoFrame> frame;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(frame, latest_frame_);
+  }
+  if (frame) {
+    PresentFrame(frame);
+  }
+  if (track_) track_->AddRenderer(this);
+}
+
+void FlutterVideoRenderer::SetMaxFrameRate(double fps) {
+  min_frame_interval_us_ = fps > 0 ? static_cast<int64_t>(1e6 / fps) : 0;
+}
+
+void FlutterVideoRenderer::SetTargetSize(size_t width, size_t height) {
+  target_width_ = width;
+  target_height_ = height;
 }
 
 bool FlutterVideoRenderer::CheckMediaStream(std::string mediaId) {
@@ -117,7 +320,8 @@ FlutterVideoRendererManager::FlutterVideoRendererManager(
 void FlutterVideoRendererManager::CreateVideoRendererTexture(
     std::unique_ptr<MethodResultProxy> result) {
   std::unique_ptr<FlutterVideoRenderer> texture(
-      new FlutterVideoRenderer(base_->textures_, base_->messenger_));
+      new FlutterVideoRenderer(base_->textures_, base_->messenger_,
+                               use_gpu_surface_));
   int64_t texture_id = texture->texture_id();
   renderers_[texture_id] = std::move(texture);
   EncodableMap params;
@@ -145,6 +349,56 @@ void FlutterVideoRendererManager::SetMediaStream(
   }
 }
 
+bool FlutterVideoRendererManager::SetVideoRendererMode(
+    const std::string& mode) {
+  if (mode == "gpuSurface") {
+    use_gpu_surface_ = true;
+  } else if (mode == "pixelBuffer") {
+    use_gpu_surface_ = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void FlutterVideoRendererManager::VideoRendererSetPaused(
+    int64_t texture_id, bool paused, bool keep_latest_frame,
+    std::unique_ptr<MethodResultProxy> result) {
+  auto it = renderers_.find(texture_id);
+  if (it == renderers_.end()) {
+    result->Error("VideoRendererSetPausedFailed",
+                  "VideoRendererSetPaused() texture not found!");
+    return;
+  }
+  it->second->SetPaused(paused, keep_latest_frame);
+  result->Success();
+}
+
+void FlutterVideoRendererManager::VideoRendererSetMaxFrameRate(
+    int64_t texture_id, double fps, std::unique_ptr<MethodResultProxy> result) {
+  auto it = renderers_.find(texture_id);
+  if (it == renderers_.end()) {
+    result->Error("VideoRendererSetMaxFrameRateFailed",
+                  "VideoRendererSetMaxFrameRate() texture not found!");
+    return;
+  }
+  it->second->SetMaxFrameRate(fps);
+  result->Success();
+}
+
+void FlutterVideoRendererManager::VideoRendererSetTargetSize(
+    int64_t texture_id, int32_t width, int32_t height,
+    std::unique_ptr<MethodResultProxy> result) {
+  auto it = renderers_.find(texture_id);
+  if (it == renderers_.end()) {
+    result->Error("VideoRendererSetTargetSizeFailed",
+                  "VideoRendererSetTargetSize() texture not found!");
+    return;
+  }
+  it->second->SetTargetSize(std::max(width, 0), std::max(height, 0));
+  result->Success();
+}
+
 void FlutterVideoRendererManager::VideoRendererDispose(
     int64_t texture_id, std::unique_ptr<MethodResultProxy> result) {
   auto it = renderers_.find(texture_id);
@@ -5,10 +5,152 @@
 
 #include "flutter_webrtc.h"
 
+#include <string>
+#include <unordered_map>
+
 #include "log.h"
 
 namespace flutter_webrtc_plugin {
 
+namespace {
+
+// Method names are resolved with a single hash lookup so that dispatch does
+// not scan the whole chain of string comparisons on every call.
+enum class Method {
+  kCreatePeerConnection,
+  kGetUserMedia,
+  kGetDisplayMedia,
+  kGetDesktopSources,
+  kUpdateDesktopSources,
+  kGetDesktopSourceThumbnail,
+  kGetSources,
+  kSelectAudioInput,
+  kSelectAudioOutput,
+  kMediaStreamGetTracks,
+  kCreateOffer,
+  kCreateAnswer,
+  kAddStream,
+  kRemoveStream,
+  kSetLocalDescription,
+  kSetRemoteDescription,
+  kAddCandidate,
+  kGetStats,
+  kStartStatsStreaming,
+  kStopStatsStreaming,
+  kStartSenderAdaptation,
+  kStopSenderAdaptation,
+  kCreateDataChannel,
+  kDataChannelSend,
+  kDataChannelSetBatched,
+  kDataChannelClose,
+  kStreamDispose,
+  kMediaStreamTrackSetEnable,
+  kTrackDispose,
+  kRestartIce,
+  kPeerConnectionClose,
+  kPeerConnectionDispose,
+  kCreateVideoRenderer,
+  kSetVideoRendererMode,
+  kVideoRendererDispose,
+  kVideoRendererSetSrcObject,
+  kVideoRendererSetPaused,
+  kVideoRendererSetMaxFrameRate,
+  kVideoRendererSetTargetSize,
+  kMediaStreamTrackSwitchCamera,
+  kSetVolume,
+  kGetLocalDescription,
+  kGetRemoteDescription,
+  kMediaStreamAddTrack,
+  kMediaStreamRemoveTrack,
+  kAddTrack,
+  kRemoveTrack,
+  kAddTransceiver,
+  kGetTransceivers,
+  kGetReceivers,
+  kGetSenders,
+  kRtpSenderDispose,
+  kRtpSenderSetTrack,
+  kRtpSenderReplaceTrack,
+  kRtpSenderSetParameters,
+  kRtpTransceiverStop,
+  kRtpTransceiverGetCurrentDirection,
+  kRtpTransceiverSetDirection,
+  kSetConfiguration,
+  kCaptureFrame,
+  kCreateLocalMediaStream,
+  kCanInsertDtmf,
+  kSendDtmf,
+};
+
+const std::unordered_map<std::string, Method> kMethods = {
+    {"createPeerConnection", Method::kCreatePeerConnection},
+    {"getUserMedia", Method::kGetUserMedia},
+    {"getDisplayMedia", Method::kGetDisplayMedia},
+    {"getDesktopSources", Method::kGetDesktopSources},
+    {"updateDesktopSources", Method::kUpdateDesktopSources},
+    {"getDesktopSourceThumbnail", Method::kGetDesktopSourceThumbnail},
+    {"getSources", Method::kGetSources},
+    {"selectAudioInput", Method::kSelectAudioInput},
+    {"selectAudioOutput", Method::kSelectAudioOutput},
+    {"mediaStreamGetTracks", Method::kMediaStreamGetTracks},
+    {"createOffer", Method::kCreateOffer},
+    {"createAnswer", Method::kCreateAnswer},
+    {"addStream", Method::kAddStream},
+    {"removeStream", Method::kRemoveStream},
+    {"setLocalDescription", Method::kSetLocalDescription},
+    {"setRemoteDescription", Method::kSetRemoteDescription},
+    {"addCandidate", Method::kAddCandidate},
+    {"getStats", Method::kGetStats},
+    {"startStatsStreaming", Method::kStartStatsStreaming},
+    {"stopStatsStreaming", Method::kStopStatsStreaming},
+    {"startSenderAdaptation", Method::kStartSenderAdaptation},
+    {"stopSenderAdaptation", Method::kStopSenderAdaptation},
+    {"createDataChannel", Method::kCreateDataChannel},
+    {"dataChannelSend", Method::kDataChannelSend},
+    {"dataChannelSetBatched", Method::kDataChannelSetBatched},
+    {"dataChannelClose", Method::kDataChannelClose},
+    {"streamDispose", Method::kStreamDispose},
+    {"mediaStreamTrackSetEnable", Method::kMediaStreamTrackSetEnable},
+    {"trackDispose", Method::kTrackDispose},
+    {"restartIce", Method::kRestartIce},
+    {"peerConnectionClose", Method::kPeerConnectionClose},
+    {"peerConnectionDispose", Method::kPeerConnectionDispose},
+    {"createVideoRenderer", Method::kCreateVideoRenderer},
+    {"setVideoRendererMode", Method::kSetVideoRendererMode},
+    {"videoRendererDispose", Method::kVideoRendererDispose},
+    {"videoRendererSetSrcObject", Method::kVideoRendererSetSrcObject},
+    {"videoRendererSetPaused", Method::kVideoRendererSetPaused},
+    {"videoRendererSetMaxFrameRate", Method::kVideoRendererSetMaxFrameRate},
+    {"videoRendererSetTargetSize", Method::kVideoRendererSetTargetSize},
+    {"mediaStreamTrackSwitchCamera", Method::kMediaStreamTrackSwitchCamera},
+    {"setVolume", Method::kSetVolume},
+    {"getLocalDescription", Method::kGetLocalDescription},
+    {"getRemoteDescription", Method::kGetRemoteDescription},
+    {"mediaStreamAddTrack", Method::kMediaStreamAddTrack},
+    {"mediaStreamRemoveTrack", Method::kMediaStreamRemoveTrack},
+    {"addTrack", Method::kAddTrack},
+    {"removeTrack", Method::kRemoveTrack},
+    {"addTransceiver", Method::kAddTransceiver},
+    {"getTransceivers", Method::kGetTransceivers},
+    {"getReceivers", Method::kGetReceivers},
+    {"getSenders", Method::kGetSenders},
+    {"rtpSenderDispose", Method::kRtpSenderDispose},
+    {"rtpSenderSetTrack", Method::kRtpSenderSetTrack},
+    {"rtpSenderReplaceTrack", Method::kRtpSenderReplaceTrack},
+    {"rtpSenderSetParameters", Method::kRtpSenderSetParameters},
+    {"rtpTransceiverStop", Method::kRtpTransceiverStop},
+    {"rtpTransceiverGetCurrentDirection",
+     Method::kRtpTransceiverGetCurrentDirection},
+    {"rtpTransceiverSetDirection", Method::kRtpTransceiverSetDirection},
+    {"setConfiguration", Method::kSetConfiguration},
+    {"captureFrame", Method::kCaptureFrame},
+    {"createLocalMediaStream", Method::kCreateLocalMediaStream},
+    {"canInsertDtmf", Method::kCanInsertDtmf},
+    {"sendDtmf", Method::kSendDtmf},
+};
+
+}  // namespace
+
 FlutterWebRTC::FlutterWebRTC(FlutterWebRTCPlugin* plugin)
     : FlutterWebRTCBase::FlutterWebRTCBase(plugin->messenger(),
                                            plugin->textures()),
@@ -22,993 +164,1342 @@ FlutterWebRTC::~FlutterWebRTC() {}
 void FlutterWebRTC::HandleMethodCall(
     const MethodCallProxy& method_call,
     std::unique_ptr<MethodResultProxy> result) {
-  if (method_call.method_name().compare("createPeerConnection") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap configuration = findMap(params, "configuration");
-    const EncodableMap constraints = findMap(params, "constraints");
-    CreateRTCPeerConnection(configuration, constraints, std::move(result));
-  } else if (method_call.method_name().compare("getUserMedia") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap constraints = findMap(params, "constraints");
-    GetUserMedia(constraints, std::move(result));
-  } else if (method_call.method_name().compare("getDisplayMedia") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap constraints = findMap(params, "constraints");
-
+  auto it = kMethods.find(method_call.method_name());
+  if (it == kMethods.end()) {
     result->NotImplemented();
-  } else if (method_call.method_name().compare("getDesktopSources") == 0) {
-    // types: ["screen", "window"]
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Bad arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    return;
+  }
 
-    const EncodableList types = findList(params, "types");
-    if (types == EncodableList()) {
-      result->Error("Bad Arguments", "Types is required");
-      return;
-    }
-    result->NotImplemented();
-  } else if (method_call.method_name().compare("updateDesktopSources") == 0) {
-    // types: ["screen", "window"]
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Bad arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  const Method method = it->second;
+  switch (method) {
+    case Method::kCreatePeerConnection: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const EncodableMap configuration = findMap(params, "configuration");
+      const EncodableMap constraints = findMap(params, "constraints");
+      CreateRTCPeerConnection(configuration, constraints, std::move(result));
+      break;
+    }
+    case Method::kGetUserMedia: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const EncodableMap constraints = findMap(params, "constraints");
+      GetUserMedia(constraints, std::move(result));
+      break;
+    }
+    case Method::kGetDisplayMedia: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const EncodableMap constraints = findMap(params, "constraints");
 
-    const EncodableList types = findList(params, "types");
-    if (types == EncodableList()) {
-      result->Error("Bad Arguments", "Types is required");
-      return;
-    }
-    result->NotImplemented();
-  } else if (method_call.method_name().compare("getDesktopSourceThumbnail") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Bad arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-
-    std::string sourceId = findString(params, "sourceId");
-    if (sourceId.empty()) {
-      result->Error("Bad Arguments", "Incorrect sourceId");
-      return;
-    }
-    const EncodableMap thumbnailSize = findMap(params, "thumbnailSize");
-    if (thumbnailSize != EncodableMap()) {
       result->NotImplemented();
-    } else {
-      result->Error("Bad Arguments", "Bad arguments received");
-    }
-  } else if (method_call.method_name().compare("getSources") == 0) {
-    GetSources(std::move(result));
-  } else if (method_call.method_name().compare("selectAudioInput") == 0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string deviceId = findString(params, "deviceId");
-    SelectAudioInput(deviceId, std::move(result));
-  } else if (method_call.method_name().compare("selectAudioOutput") == 0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string deviceId = findString(params, "deviceId");
-    SelectAudioOutput(deviceId, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamGetTracks") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
-    MediaStreamGetTracks(streamId, std::move(result));
-  } else if (method_call.method_name().compare("createOffer") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "constraints");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("createOfferFailed",
-                    "createOffer() peerConnection is null");
-      return;
-    }
-    CreateOffer(constraints, pc, std::move(result));
-  } else if (method_call.method_name().compare("createAnswer") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "constraints");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("createAnswerFailed",
-                    "createAnswer() peerConnection is null");
-      return;
-    }
-    CreateAnswer(constraints, pc, std::move(result));
-  } else if (method_call.method_name().compare("addStream") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
-    if (!stream) {
-      result->Error("addStreamFailed", "addStream() stream not found!");
-      return;
-    }
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("addStreamFailed", "addStream() peerConnection is null");
-      return;
-    }
-    pc->AddStream(stream);
-    result->Success();
-  } else if (method_call.method_name().compare("removeStream") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
-    if (!stream) {
-      result->Error("removeStreamFailed", "removeStream() stream not found!");
-      return;
-    }
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("removeStreamFailed",
-                    "removeStream() peerConnection is null");
-      return;
-    }
-    pc->RemoveStream(stream);
-    result->Success();
-  } else if (method_call.method_name().compare("setLocalDescription") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("setLocalDescriptionFailed",
-                    "setLocalDescription() peerConnection is null");
-      return;
-    }
-
-    SdpParseError error;
-    scoped_refptr<RTCSessionDescription> description =
-        RTCSessionDescription::Create(findString(constraints, "type").c_str(),
-                                      findString(constraints, "sdp").c_str(),
-                                      &error);
-
-    SetLocalDescription(description.get(), pc, std::move(result));
-  } else if (method_call.method_name().compare("setRemoteDescription") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("setRemoteDescriptionFailed",
-                    "setRemoteDescription() peerConnection is null");
-      return;
-    }
-
-    SdpParseError error;
-    scoped_refptr<RTCSessionDescription> description =
-        RTCSessionDescription::Create(findString(constraints, "type").c_str(),
-                                      findString(constraints, "sdp").c_str(),
-                                      &error);
-
-    SetRemoteDescription(description.get(), pc, std::move(result));
-  } else if (method_call.method_name().compare("addCandidate") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "candidate");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("addCandidateFailed",
-                    "addCandidate() peerConnection is null");
-      return;
-    }
-
-    SdpParseError error;
-    int sdpMLineIndex = findInt(constraints, "sdpMLineIndex");
-    scoped_refptr<RTCIceCandidate> rtc_candidate = RTCIceCandidate::Create(
-        findString(constraints, "candidate").c_str(),
-        findString(constraints, "sdpMid").c_str(),
-        sdpMLineIndex == -1 ? 0 : sdpMLineIndex, &error);
-
-    AddIceCandidate(rtc_candidate.get(), pc, std::move(result));
-  } else if (method_call.method_name().compare("getStats") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string track_id = findString(params, "trackId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getStatsFailed", "getStats() peerConnection is null");
-      return;
-    }
-    GetStats(track_id, pc, std::move(result));
-  } else if (method_call.method_name().compare("createDataChannel") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("createDataChannelFailed",
-                    "createDataChannel() peerConnection is null");
-      return;
-    }
-
-    const std::string label = findString(params, "label");
-    const EncodableMap dataChannelDict = findMap(params, "dataChannelDict");
-
-    CreateDataChannel(peerConnectionId, label, dataChannelDict, pc,
-                      std::move(result));
-  } else if (method_call.method_name().compare("dataChannelSend") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("dataChannelSendFailed",
-                    "dataChannelSend() peerConnection is null");
-      return;
-    }
-
-    const std::string dataChannelId = findString(params, "dataChannelId");
-    const std::string type = findString(params, "type");
-    const EncodableValue data = findEncodableValue(params, "data");
-    RTCDataChannel* data_channel = DataChannelForId(dataChannelId);
-    if (data_channel == nullptr) {
-      result->Error("dataChannelSendFailed",
-                    "dataChannelSend() data_channel is null");
-      return;
-    }
-    DataChannelSend(data_channel, type, data, std::move(result));
-  } else if (method_call.method_name().compare("dataChannelClose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("dataChannelCloseFailed",
-                    "dataChannelClose() peerConnection is null");
-      return;
-    }
-
-    const std::string dataChannelId = findString(params, "dataChannelId");
-    RTCDataChannel* data_channel = DataChannelForId(dataChannelId);
-    if (data_channel == nullptr) {
-      result->Error("dataChannelCloseFailed",
-                    "dataChannelClose() data_channel is null");
-      return;
-    }
-    DataChannelClose(data_channel, dataChannelId, std::move(result));
-  } else if (method_call.method_name().compare("streamDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string stream_id = findString(params, "streamId");
-    MediaStreamDispose(stream_id, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamTrackSetEnable") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
-    const EncodableValue enable = findEncodableValue(params, "enabled");
-    RTCMediaTrack* track = MediaTrackForId(track_id);
-    if (nullptr == track) {
-      result->Error("mediaStreamTrackSetEnableFailed",
-                    "mediaStreamTrackSetEnable() track is null");
-      return;
-    }
-    track->set_enabled(GetValue<bool>(enable));
-    result->Success();
-  } else if (method_call.method_name().compare("trackDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
-    MediaStreamTrackDispose(track_id, std::move(result));
-  } else if (method_call.method_name().compare("restartIce") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("restartIceFailed", "restartIce() peerConnection is null");
-      return;
-    }
-    pc->RestartIce();
-    result->Success();
-  } else if (method_call.method_name().compare("peerConnectionClose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("peerConnectionCloseFailed",
-                    "peerConnectionClose() peerConnection is null");
-      return;
-    }
-    RTCPeerConnectionClose(pc, peerConnectionId, std::move(result));
-  } else if (method_call.method_name().compare("peerConnectionDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("peerConnectionDisposeFailed",
-                    "peerConnectionDisposeClose() peerConnection is null");
-      return;
-    }
-    RTCPeerConnectionDispose(pc, peerConnectionId, std::move(result));
-  } else if (method_call.method_name().compare("createVideoRenderer") == 0) {
-    CreateVideoRendererTexture(std::move(result));
-  } else if (method_call.method_name().compare("videoRendererDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    int64_t texture_id = findLongInt(params, "textureId");
-    VideoRendererDispose(texture_id, std::move(result));
-  } else if (method_call.method_name().compare("videoRendererSetSrcObject") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string stream_id = findString(params, "streamId");
-    int64_t texture_id = findLongInt(params, "textureId");
-    const std::string peerConnectionId = findString(params, "ownerTag");
-
-    SetMediaStream(texture_id, stream_id, peerConnectionId);
-    result->Success();
-  } else if (method_call.method_name().compare(
-                 "mediaStreamTrackSwitchCamera") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
-    MediaStreamTrackSwitchCamera(track_id, std::move(result));
-  } else if (method_call.method_name().compare("setVolume") == 0) {
-  } else if (method_call.method_name().compare("getLocalDescription") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("GetLocalDescription",
-                    "GetLocalDescription() peerConnection is null");
-      return;
-    }
-
-    GetLocalDescription(pc, std::move(result));
-  } else if (method_call.method_name().compare("getRemoteDescription") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("GetRemoteDescription",
-                    "GetRemoteDescription() peerConnection is null");
-      return;
-    }
-
-    GetRemoteDescription(pc, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamAddTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-
-    const std::string streamId = findString(params, "streamId");
-    const std::string trackId = findString(params, "trackId");
-
-    scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
-    if (stream == nullptr) {
-      result->Error("MediaStreamAddTrack",
-                    "MediaStreamAddTrack() stream is null");
-      return;
-    }
-
-    scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
-    if (track == nullptr) {
-      result->Error("MediaStreamAddTrack",
-                    "MediaStreamAddTrack() track is null");
-      return;
-    }
-
-    MediaStreamAddTrack(stream, track, std::move(result));
-    std::string kind = track->kind().std_string();
-    for (int i = 0; i < renders_.size(); i++) {
-      FlutterVideoRenderer* renderer = renders_.at(i).get();
-      if (renderer->CheckMediaStream(streamId) && 0 == kind.compare("video")) {
-        renderer->SetVideoTrack(static_cast<RTCVideoTrack*>(track.get()));
-      }
-    };
-  } else if (method_call.method_name().compare("mediaStreamRemoveTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-
-    const std::string streamId = findString(params, "streamId");
-    const std::string trackId = findString(params, "trackId");
-
-    scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
-    if (stream == nullptr) {
-      result->Error("MediaStreamRemoveTrack",
-                    "MediaStreamRemoveTrack() stream is null");
-      return;
-    }
-
-    scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
-    if (track == nullptr) {
-      result->Error("MediaStreamRemoveTrack",
-                    "MediaStreamRemoveTrack() track is null");
-      return;
-    }
-
-    MediaStreamRemoveTrack(stream, track, std::move(result));
-
-    for (int i = 0; i < renders_.size(); i++) {
-      FlutterVideoRenderer* renderer = renders_.at(i).get();
-      if (renderer->CheckVideoTrack(streamId)) {
-        renderer->SetVideoTrack(nullptr);
-      }
-    };
-  } else if (method_call.method_name().compare("addTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string trackId = findString(params, "trackId");
-    const EncodableList streamIds = findList(params, "streamIds");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("AddTrack", "AddTrack() peerConnection is null");
-      return;
+      break;
     }
+    case Method::kGetDesktopSources: {
+      // types: ["screen", "window"]
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Bad arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
 
-    scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
-    if (track == nullptr) {
-      result->Error("AddTrack", "AddTrack() track is null");
-      return;
-    };
-    std::list<std::string> listId;
-    for (EncodableValue value : streamIds) {
-      listId.push_back(GetValue<std::string>(value));
+      const EncodableList types = findList(params, "types");
+      if (types == EncodableList()) {
+        result->Error("Bad Arguments", "Types is required");
+        return;
+      }
+      result->NotImplemented();
+      break;
     }
+    case Method::kUpdateDesktopSources: {
+      // types: ["screen", "window"]
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Bad arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
 
-    AddTrack(pc, track, listId, std::move(result));
+      const EncodableList types = findList(params, "types");
+      if (types == EncodableList()) {
+        result->Error("Bad Arguments", "Types is required");
+        return;
+      }
+      result->NotImplemented();
+      break;
+    }
+    case Method::kGetDesktopSourceThumbnail: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Bad arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
 
-  } else if (method_call.method_name().compare("removeTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+      std::string sourceId = findString(params, "sourceId");
+      if (sourceId.empty()) {
+        result->Error("Bad Arguments", "Incorrect sourceId");
+        return;
+      }
+      const EncodableMap thumbnailSize = findMap(params, "thumbnailSize");
+      if (thumbnailSize != EncodableMap()) {
+        result->NotImplemented();
+      } else {
+        result->Error("Bad Arguments", "Bad arguments received");
+      }
+      break;
+    }
+    case Method::kGetSources: {
+      GetSources(std::move(result));
+      break;
+    }
+    case Method::kSelectAudioInput: {
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string deviceId = findString(params, "deviceId");
+      SelectAudioInput(deviceId, std::move(result));
+      break;
+    }
+    case Method::kSelectAudioOutput: {
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string deviceId = findString(params, "deviceId");
+      SelectAudioOutput(deviceId, std::move(result));
+      break;
+    }
+    case Method::kMediaStreamGetTracks: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string streamId = findString(params, "streamId");
+      MediaStreamGetTracks(streamId, std::move(result));
+      break;
+    }
+    case Method::kCreateOffer: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const EncodableMap constraints = findMap(params, "constraints");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("createOfferFailed",
+                      "createOffer() peerConnection is null");
+        return;
+      }
+      CreateOffer(constraints, pc, std::move(result));
+      break;
+    }
+    case Method::kCreateAnswer: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const EncodableMap constraints = findMap(params, "constraints");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("createAnswerFailed",
+                      "createAnswer() peerConnection is null");
+        return;
+      }
+      CreateAnswer(constraints, pc, std::move(result));
+      break;
+    }
+    case Method::kAddStream: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string streamId = findString(params, "streamId");
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+
+      scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
+      if (!stream) {
+        result->Error("addStreamFailed", "addStream() stream not found!");
+        return;
+      }
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("addStreamFailed", "addStream() peerConnection is null");
+        return;
+      }
+      pc->AddStream(stream);
+      result->Success();
+      break;
+    }
+    case Method::kRemoveStream: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string streamId = findString(params, "streamId");
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+
+      scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
+      if (!stream) {
+        result->Error("removeStreamFailed", "removeStream() stream not found!");
+        return;
+      }
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("removeStreamFailed",
+                      "removeStream() peerConnection is null");
+        return;
+      }
+      pc->RemoveStream(stream);
+      result->Success();
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    case Method::kSetLocalDescription: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const EncodableMap constraints = findMap(params, "description");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("setLocalDescriptionFailed",
+                      "setLocalDescription() peerConnection is null");
+        return;
+      }
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string senderId = findString(params, "senderId");
+      SdpParseError error;
+      scoped_refptr<RTCSessionDescription> description =
+          RTCSessionDescription::Create(findString(constraints, "type").c_str(),
+                                        findString(constraints, "sdp").c_str(),
+                                        &error);
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("removeTrack", "removeTrack() peerConnection is null");
-      return;
+      SetLocalDescription(description.get(), pc, std::move(result));
+      break;
     }
+    case Method::kSetRemoteDescription: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const EncodableMap constraints = findMap(params, "description");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("setRemoteDescriptionFailed",
+                      "setRemoteDescription() peerConnection is null");
+        return;
+      }
 
-    RemoveTrack(pc, senderId, std::move(result));
+      SdpParseError error;
+      scoped_refptr<RTCSessionDescription> description =
+          RTCSessionDescription::Create(findString(constraints, "type").c_str(),
+                                        findString(constraints, "sdp").c_str(),
+                                        &error);
 
-  } else if (method_call.method_name().compare("addTransceiver") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+      SetRemoteDescription(description.get(), pc, std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap transceiverInit = findMap(params, "transceiverInit");
-    const std::string mediaType = findString(params, "mediaType");
-    const std::string trackId = findString(params, "trackId");
+    case Method::kAddCandidate: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const EncodableMap constraints = findMap(params, "candidate");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("addCandidateFailed",
+                      "addCandidate() peerConnection is null");
+        return;
+      }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("addTransceiver",
-                    "addTransceiver() peerConnection is null");
-      return;
+      SdpParseError error;
+      int sdpMLineIndex = findInt(constraints, "sdpMLineIndex");
+      scoped_refptr<RTCIceCandidate> rtc_candidate = RTCIceCandidate::Create(
+          findString(constraints, "candidate").c_str(),
+          findString(constraints, "sdpMid").c_str(),
+          sdpMLineIndex == -1 ? 0 : sdpMLineIndex, &error);
+
+      AddIceCandidate(rtc_candidate.get(), pc, std::move(result));
+      break;
     }
-    AddTransceiver(pc, trackId, mediaType, transceiverInit, std::move(result));
-  } else if (method_call.method_name().compare("getTransceivers") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+    case Method::kGetStats: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const std::string track_id = findString(params, "trackId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("getStatsFailed", "getStats() peerConnection is null");
+        return;
+      }
+      GetStats(track_id, pc, std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getTransceivers",
-                    "getTransceivers() peerConnection is null");
-      return;
+    case Method::kStartStatsStreaming: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("startStatsStreamingFailed",
+                      "startStatsStreaming() peerConnection is null");
+        return;
+      }
+      int interval_ms = findInt(params, "interval");
+      if (interval_ms <= 0) {
+        interval_ms = 1000;
+      }
+      std::vector<std::string> fields;
+      for (const EncodableValue& field : findList(params, "fields")) {
+        if (TypeIs<std::string>(field)) {
+          fields.push_back(GetValue<std::string>(field));
+        }
+      }
+      StartStatsStreaming(pc, peerConnectionId, interval_ms / 1000.0, fields,
+                          std::move(result));
+      break;
     }
-
-    GetTransceivers(pc, std::move(result));
-  } else if (method_call.method_name().compare("getReceivers") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+    case Method::kStopStatsStreaming: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      StopStatsStreaming(peerConnectionId, std::move(result));
+      break;
+    }
+    case Method::kStartSenderAdaptation: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("startSenderAdaptationFailed",
+                      "startSenderAdaptation() peerConnection is null");
+        return;
+      }
+      FlutterSenderAdaptation::Config config;
+      int interval_ms = findInt(params, "interval");
+      if (interval_ms > 0) {
+        config.interval = interval_ms / 1000.0;
+      }
+      config.high_cpu_usage = toDouble(
+          findEncodableValue(params, "highCpuUsage"), config.high_cpu_usage);
+      config.low_cpu_usage = toDouble(findEncodableValue(params, "lowCpuUsage"),
+                                      config.low_cpu_usage);
+      config.max_framerate = toDouble(
+          findEncodableValue(params, "maxFramerate"), config.max_framerate);
+      if (config.low_cpu_usage >= config.high_cpu_usage) {
+        result->Error("startSenderAdaptationFailed",
+                      "startSenderAdaptation() lowCpuUsage must be less than "
+                      "highCpuUsage");
+        return;
+      }
+      StartSenderAdaptation(pc, peerConnectionId, config, std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    case Method::kStopSenderAdaptation: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      StopSenderAdaptation(peerConnectionId, std::move(result));
+      break;
+    }
+    case Method::kCreateDataChannel: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getReceivers", "getReceivers() peerConnection is null");
-      return;
-    }
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("createDataChannelFailed",
+                      "createDataChannel() peerConnection is null");
+        return;
+      }
 
-    GetReceivers(pc, std::move(result));
+      const std::string label = findString(params, "label");
+      const EncodableMap dataChannelDict = findMap(params, "dataChannelDict");
 
-  } else if (method_call.method_name().compare("getSenders") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+      CreateDataChannel(peerConnectionId, label, dataChannelDict, pc,
+                        std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    case Method::kDataChannelSend: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      // Borrow the arguments so that the payload is not copied before sending.
+      const EncodableMap& params =
+          std::get<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("dataChannelSendFailed",
+                      "dataChannelSend() peerConnection is null");
+        return;
+      }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getSenders", "getSenders() peerConnection is null");
-      return;
+      const std::string dataChannelId = findString(params, "dataChannelId");
+      const std::string type = findString(params, "type");
+      auto data = params.find(EncodableValue("data"));
+      scoped_refptr<RTCDataChannel> data_channel =
+          DataChannelForId(dataChannelId);
+      if (data_channel == nullptr) {
+        result->Error("dataChannelSendFailed",
+                      "dataChannelSend() data_channel is null");
+        return;
+      }
+      if (data == params.end()) {
+        result->Error("dataChannelSendFailed",
+                      "dataChannelSend() data is null");
+        return;
+      }
+      DataChannelSend(data_channel, type, data->second, std::move(result));
+      break;
     }
+    case Method::kDataChannelSetBatched: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string dataChannelId = findString(params, "dataChannelId");
+      auto it = params.find(EncodableValue("batched"));
+      bool batched = it != params.end() && TypeIs<bool>(it->second) &&
+                     GetValue<bool>(it->second);
+      DataChannelSetBatched(dataChannelId, batched, std::move(result));
+      break;
+    }
+    case Method::kDataChannelClose: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("dataChannelCloseFailed",
+                      "dataChannelClose() peerConnection is null");
+        return;
+      }
 
-    GetSenders(pc, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+      const std::string dataChannelId = findString(params, "dataChannelId");
+      scoped_refptr<RTCDataChannel> data_channel =
+          DataChannelForId(dataChannelId);
+      if (data_channel == nullptr) {
+        result->Error("dataChannelCloseFailed",
+                      "dataChannelClose() data_channel is null");
+        return;
+      }
+      DataChannelClose(data_channel, dataChannelId, std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpSenderDispose",
-                    "rtpSenderDispose() peerConnection is null");
-      return;
+    case Method::kStreamDispose: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string stream_id = findString(params, "streamId");
+      MediaStreamDispose(stream_id, std::move(result));
+      break;
+    }
+    case Method::kMediaStreamTrackSetEnable: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string track_id = findString(params, "trackId");
+      const EncodableValue enable = findEncodableValue(params, "enabled");
+      scoped_refptr<RTCMediaTrack> track = MediaTrackForId(track_id);
+      if (nullptr == track) {
+        result->Error("mediaStreamTrackSetEnableFailed",
+                      "mediaStreamTrackSetEnable() track is null");
+        return;
+      }
+      track->set_enabled(GetValue<bool>(enable));
+      result->Success();
+      break;
     }
-
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    if (0 < rtpSenderId.size()) {
+    case Method::kTrackDispose: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string track_id = findString(params, "trackId");
+      MediaStreamTrackDispose(track_id, std::move(result));
+      break;
+    }
+    case Method::kRestartIce: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
       if (pc == nullptr) {
-        result->Error("rtpSenderDispose",
-                      "rtpSenderDispose() rtpSenderId is null or empty");
+        result->Error("restartIceFailed",
+                      "restartIce() peerConnection is null");
         return;
       }
+      pc->RestartIce();
+      result->Success();
+      break;
     }
-    RtpSenderDispose(pc, rtpSenderId, std::move(result));
+    case Method::kPeerConnectionClose: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("peerConnectionCloseFailed",
+                      "peerConnectionClose() peerConnection is null");
+        return;
+      }
+      RTCPeerConnectionClose(pc, peerConnectionId, std::move(result));
+      break;
+    }
+    case Method::kPeerConnectionDispose: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("peerConnectionDisposeFailed",
+                      "peerConnectionDisposeClose() peerConnection is null");
+        return;
+      }
+      RTCPeerConnectionDispose(pc, peerConnectionId, std::move(result));
+      break;
+    }
+    case Method::kCreateVideoRenderer: {
+      CreateVideoRendererTexture(std::move(result));
+      break;
+    }
+    case Method::kSetVideoRendererMode: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string mode = findString(params, "mode");
+      if (!SetVideoRendererMode(mode)) {
+        result->Error("Bad Arguments", "Unknown video renderer mode: " + mode);
+        return;
+      }
+      result->Success();
+      break;
+    }
+    case Method::kVideoRendererDispose: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      int64_t texture_id = findLongInt(params, "textureId");
+      VideoRendererDispose(texture_id, std::move(result));
+      break;
+    }
+    case Method::kVideoRendererSetSrcObject: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string stream_id = findString(params, "streamId");
+      int64_t texture_id = findLongInt(params, "textureId");
+      const std::string peerConnectionId = findString(params, "ownerTag");
+
+      SetMediaStream(texture_id, stream_id, peerConnectionId);
+      result->Success();
+      break;
+    }
+    case Method::kVideoRendererSetPaused: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      int64_t texture_id = findLongInt(params, "textureId");
+      EncodableValue paused = findEncodableValue(params, "paused");
+      if (!TypeIs<bool>(paused)) {
+        result->Error("Bad Arguments",
+                      "videoRendererSetPaused() paused is null");
+        return;
+      }
+      EncodableValue keep_latest_frame =
+          findEncodableValue(params, "keepLatestFrame");
+      VideoRendererSetPaused(
+          texture_id, GetValue<bool>(paused),
+          TypeIs<bool>(keep_latest_frame) && GetValue<bool>(keep_latest_frame),
+          std::move(result));
+      break;
+    }
+    case Method::kVideoRendererSetMaxFrameRate: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      int64_t texture_id = findLongInt(params, "textureId");
+      double fps = toDouble(findEncodableValue(params, "maxFrameRate"), 0.0);
+      VideoRendererSetMaxFrameRate(texture_id, fps, std::move(result));
+      break;
+    }
+    case Method::kVideoRendererSetTargetSize: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      int64_t texture_id = findLongInt(params, "textureId");
+      int32_t width = toInt(findEncodableValue(params, "width"), 0);
+      int32_t height = toInt(findEncodableValue(params, "height"), 0);
+      VideoRendererSetTargetSize(texture_id, width, height, std::move(result));
+      break;
+    }
+    case Method::kMediaStreamTrackSwitchCamera: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string track_id = findString(params, "trackId");
+      MediaStreamTrackSwitchCamera(track_id, std::move(result));
+      break;
+    }
+    case Method::kSetVolume:
+      break;
+    case Method::kGetLocalDescription: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const EncodableMap constraints = findMap(params, "description");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("GetLocalDescription",
+                      "GetLocalDescription() peerConnection is null");
+        return;
+      }
 
-  } else if (method_call.method_name().compare("rtpSenderSetTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+      GetLocalDescription(pc, std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    case Method::kGetRemoteDescription: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const EncodableMap constraints = findMap(params, "description");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("GetRemoteDescription",
+                      "GetRemoteDescription() peerConnection is null");
+        return;
+      }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpSenderSetTrack",
-                    "rtpSenderSetTrack() peerConnection is null");
-      return;
+      GetRemoteDescription(pc, std::move(result));
+      break;
     }
+    case Method::kMediaStreamAddTrack: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
 
-    const std::string trackId = findString(params, "trackId");
-    RTCMediaTrack* track = MediaTrackForId(trackId);
+      const std::string streamId = findString(params, "streamId");
+      const std::string trackId = findString(params, "trackId");
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    if (0 < rtpSenderId.size()) {
-      if (pc == nullptr) {
-        result->Error("rtpSenderSetTrack",
-                      "rtpSenderSetTrack() rtpSenderId is null or empty");
+      scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
+      if (stream == nullptr) {
+        result->Error("MediaStreamAddTrack",
+                      "MediaStreamAddTrack() stream is null");
         return;
       }
+
+      scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
+      if (track == nullptr) {
+        result->Error("MediaStreamAddTrack",
+                      "MediaStreamAddTrack() track is null");
+        return;
+      }
+
+      MediaStreamAddTrack(stream, track, std::move(result));
+      std::string kind = track->kind().std_string();
+      for (int i = 0; i < renders_.size(); i++) {
+        FlutterVideoRenderer* renderer = renders_.at(i).get();
+        if (renderer->CheckMediaStream(streamId) &&
+            0 == kind.compare("video")) {
+          renderer->SetVideoTrack(static_cast<RTCVideoTrack*>(track.get()));
+        }
+      };
+      break;
+    }
+    case Method::kMediaStreamRemoveTrack: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+
+      const std::string streamId = findString(params, "streamId");
+      const std::string trackId = findString(params, "trackId");
+
+      scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
+      if (stream == nullptr) {
+        result->Error("MediaStreamRemoveTrack",
+                      "MediaStreamRemoveTrack() stream is null");
+        return;
+      }
+
+      scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
+      if (track == nullptr) {
+        result->Error("MediaStreamRemoveTrack",
+                      "MediaStreamRemoveTrack() track is null");
+        return;
+      }
+
+      MediaStreamRemoveTrack(stream, track, std::move(result));
+
+      for (int i = 0; i < renders_.size(); i++) {
+        FlutterVideoRenderer* renderer = renders_.at(i).get();
+        if (renderer->CheckVideoTrack(streamId)) {
+          renderer->SetVideoTrack(nullptr);
+        }
+      };
+      break;
     }
-    RtpSenderSetTrack(pc, track, rtpSenderId, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderReplaceTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    case Method::kAddTrack: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpSenderReplaceTrack",
-                    "rtpSenderReplaceTrack() peerConnection is null");
-      return;
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const std::string trackId = findString(params, "trackId");
+      const EncodableList streamIds = findList(params, "streamIds");
+
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("AddTrack", "AddTrack() peerConnection is null");
+        return;
+      }
+
+      scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
+      if (track == nullptr) {
+        result->Error("AddTrack", "AddTrack() track is null");
+        return;
+      };
+      std::list<std::string> listId;
+      for (EncodableValue value : streamIds) {
+        listId.push_back(GetValue<std::string>(value));
+      }
+
+      AddTrack(pc, track, listId, std::move(result));
+      break;
     }
+    case Method::kRemoveTrack: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
 
-    const std::string trackId = findString(params, "trackId");
-    RTCMediaTrack* track = MediaTrackForId(trackId);
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const std::string senderId = findString(params, "senderId");
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    if (0 < rtpSenderId.size()) {
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
       if (pc == nullptr) {
-        result->Error("rtpSenderReplaceTrack",
-                      "rtpSenderReplaceTrack() rtpSenderId is null or empty");
+        result->Error("removeTrack", "removeTrack() peerConnection is null");
         return;
       }
+
+      RemoveTrack(pc, senderId, std::move(result));
+      break;
     }
-    RtpSenderReplaceTrack(pc, track, rtpSenderId, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderSetParameters") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+    case Method::kAddTransceiver: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const EncodableMap transceiverInit = findMap(params, "transceiverInit");
+      const std::string mediaType = findString(params, "mediaType");
+      const std::string trackId = findString(params, "trackId");
+
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("addTransceiver",
+                      "addTransceiver() peerConnection is null");
+        return;
+      }
+      AddTransceiver(pc,
+                     trackId, mediaType, transceiverInit, std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    case Method::kGetTransceivers: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpSenderSetParameters",
-                    "rtpSenderSetParameters() peerConnection is null");
-      return;
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("getTransceivers",
+                      "getTransceivers() peerConnection is null");
+        return;
+      }
+
+      GetTransceivers(pc, std::move(result));
+      break;
     }
+    case Method::kGetReceivers: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    if (0 < rtpSenderId.size()) {
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
       if (pc == nullptr) {
-        result->Error("rtpSenderSetParameters",
-                      "rtpSenderSetParameters() rtpSenderId is null or empty");
+        result->Error("getReceivers", "getReceivers() peerConnection is null");
         return;
       }
-    }
 
-    const EncodableMap parameters = findMap(params, "parameters");
-    if (0 < parameters.size()) {
-      result->Error("rtpSenderSetParameters",
-                    "rtpSenderSetParameters() parameters is null or empty");
-      return;
+      GetReceivers(pc, std::move(result));
+      break;
     }
+    case Method::kGetSenders: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    RtpSenderSetParameters(pc, rtpSenderId, parameters, std::move(result));
-  } else if (method_call.method_name().compare("rtpTransceiverStop") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("getSenders", "getSenders() peerConnection is null");
+        return;
+      }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpTransceiverStop",
-                    "rtpTransceiverStop() peerConnection is null");
-      return;
+      GetSenders(pc, std::move(result));
+      break;
     }
+    case Method::kRtpSenderDispose: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    const std::string rtpTransceiverId = findString(params, "rtpTransceiverId");
-    if (0 < rtpTransceiverId.size()) {
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
       if (pc == nullptr) {
-        result->Error("rtpTransceiverStop",
-                      "rtpTransceiverStop() rtpTransceiverId is null or empty");
+        result->Error("rtpSenderDispose",
+                      "rtpSenderDispose() peerConnection is null");
         return;
       }
-    }
 
-    RtpTransceiverStop(pc, rtpTransceiverId, std::move(result));
-  } else if (method_call.method_name().compare(
-                 "rtpTransceiverGetCurrentDirection") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+      const std::string rtpSenderId = findString(params, "rtpSenderId");
+      if (0 < rtpSenderId.size()) {
+        if (pc == nullptr) {
+          result->Error("rtpSenderDispose",
+                        "rtpSenderDispose() rtpSenderId is null or empty");
+          return;
+        }
+      }
+      RtpSenderDispose(pc, rtpSenderId, std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    case Method::kRtpSenderSetTrack: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error(
-          "rtpTransceiverGetCurrentDirection",
-          "rtpTransceiverGetCurrentDirection() peerConnection is null");
-      return;
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("rtpSenderSetTrack",
+                      "rtpSenderSetTrack() peerConnection is null");
+        return;
+      }
+
+      const std::string trackId = findString(params, "trackId");
+      scoped_refptr<RTCMediaTrack> track = MediaTrackForId(trackId);
+
+      const std::string rtpSenderId = findString(params, "rtpSenderId");
+      if (0 < rtpSenderId.size()) {
+        if (pc == nullptr) {
+          result->Error("rtpSenderSetTrack",
+                        "rtpSenderSetTrack() rtpSenderId is null or empty");
+          return;
+        }
+      }
+      RtpSenderSetTrack(pc, track, rtpSenderId, std::move(result));
+      break;
     }
+    case Method::kRtpSenderReplaceTrack: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    const std::string rtpTransceiverId = findString(params, "rtpTransceiverId");
-    if (0 < rtpTransceiverId.size()) {
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
       if (pc == nullptr) {
-        result->Error("rtpTransceiverGetCurrentDirection",
-                      "rtpTransceiverGetCurrentDirection() rtpTransceiverId is "
-                      "null or empty");
+        result->Error("rtpSenderReplaceTrack",
+                      "rtpSenderReplaceTrack() peerConnection is null");
         return;
       }
-    }
 
-    RtpTransceiverGetCurrentDirection(pc, rtpTransceiverId, std::move(result));
-  } else if (method_call.method_name().compare("rtpTransceiverSetDirection") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+      const std::string trackId = findString(params, "trackId");
+      scoped_refptr<RTCMediaTrack> track = MediaTrackForId(trackId);
+
+      const std::string rtpSenderId = findString(params, "rtpSenderId");
+      if (0 < rtpSenderId.size()) {
+        if (pc == nullptr) {
+          result->Error("rtpSenderReplaceTrack",
+                        "rtpSenderReplaceTrack() rtpSenderId is null or empty");
+          return;
+        }
+      }
+      RtpSenderReplaceTrack(pc, track, rtpSenderId, std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    case Method::kRtpSenderSetParameters: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("rtpSenderSetParameters",
+                      "rtpSenderSetParameters() peerConnection is null");
+        return;
+      }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpTransceiverSetDirection",
-                    "rtpTransceiverSetDirection() peerConnection is null");
-      return;
+      const std::string rtpSenderId = findString(params, "rtpSenderId");
+      if (0 < rtpSenderId.size()) {
+        if (pc == nullptr) {
+          result->Error(
+              "rtpSenderSetParameters",
+              "rtpSenderSetParameters() rtpSenderId is null or empty");
+          return;
+        }
+      }
+
+      const EncodableMap parameters = findMap(params, "parameters");
+      if (0 < parameters.size()) {
+        result->Error("rtpSenderSetParameters",
+                      "rtpSenderSetParameters() parameters is null or empty");
+        return;
+      }
+
+      RtpSenderSetParameters(pc, rtpSenderId, parameters, std::move(result));
+      break;
     }
+    case Method::kRtpTransceiverStop: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    const std::string rtpTransceiverId = findString(params, "transceiverId");
-    if (0 < rtpTransceiverId.size()) {
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
       if (pc == nullptr) {
-        result->Error("rtpTransceiverGetCurrentDirection",
-                      "rtpTransceiverGetCurrentDirection() transceiverId is "
-                      "null or empty");
+        result->Error("rtpTransceiverStop",
+                      "rtpTransceiverStop() peerConnection is null");
         return;
       }
+
+      const std::string rtpTransceiverId =
+          findString(params, "rtpTransceiverId");
+      if (0 < rtpTransceiverId.size()) {
+        if (pc == nullptr) {
+          result->Error(
+              "rtpTransceiverStop",
+              "rtpTransceiverStop() rtpTransceiverId is null or empty");
+          return;
+        }
+      }
+
+      RtpTransceiverStop(pc, rtpTransceiverId, std::move(result));
+      break;
     }
+    case Method::kRtpTransceiverGetCurrentDirection: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    const std::string direction = findString(params, "direction");
-    if (0 < rtpTransceiverId.size()) {
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
       if (pc == nullptr) {
         result->Error(
             "rtpTransceiverGetCurrentDirection",
-            "rtpTransceiverGetCurrentDirection() direction is null or empty");
+            "rtpTransceiverGetCurrentDirection() peerConnection is null");
         return;
       }
-    }
 
-    RtpTransceiverSetDirection(pc, rtpTransceiverId, direction,
-                               std::move(result));
-  } else if (method_call.method_name().compare("setConfiguration") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+      const std::string rtpTransceiverId =
+          findString(params, "rtpTransceiverId");
+      if (0 < rtpTransceiverId.size()) {
+        if (pc == nullptr) {
+          result->Error("rtpTransceiverGetCurrentDirection",
+                        "rtpTransceiverGetCurrentDirection() "
+                        "rtpTransceiverId is null or empty");
+          return;
+        }
+      }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("setConfiguration",
-                    "setConfiguration() peerConnection is null");
-      return;
+      RtpTransceiverGetCurrentDirection(pc,
+                                        rtpTransceiverId, std::move(result));
+      break;
     }
+    case Method::kRtpTransceiverSetDirection: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
 
-    const EncodableMap configuration = findMap(params, "configuration");
-    if (0 < configuration.size()) {
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
       if (pc == nullptr) {
-        result->Error("setConfiguration",
-                      "setConfiguration() configuration is null or empty");
+        result->Error("rtpTransceiverSetDirection",
+                      "rtpTransceiverSetDirection() peerConnection is null");
         return;
       }
-    }
-    SetConfiguration(pc, configuration, std::move(result));
-  } else if (method_call.method_name().compare("captureFrame") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
 
-    const std::string path = findString(params, "path");
-    if (0 < path.size()) {
-      result->Error("captureFrame", "captureFrame() path is null or empty");
-      return;
-    }
+      const std::string rtpTransceiverId = findString(params, "transceiverId");
+      if (0 < rtpTransceiverId.size()) {
+        if (pc == nullptr) {
+          result->Error("rtpTransceiverGetCurrentDirection",
+                        "rtpTransceiverGetCurrentDirection() transceiverId is "
+                        "null or empty");
+          return;
+        }
+      }
 
-    const std::string trackId = findString(params, "trackId");
-    RTCMediaTrack* track = MediaTrackForId(trackId);
-    if (nullptr == track) {
-      result->Error("captureFrame", "captureFrame() track is null");
-      return;
-    }
-    std::string kind = track->kind().std_string();
-    if (0 != kind.compare("video")) {
-      result->Error("captureFrame", "captureFrame() track not is video track");
-      return;
-    }
-    CaptureFrame((RTCVideoTrack*)track, path, std::move(result));
+      const std::string direction = findString(params, "direction");
+      if (0 < rtpTransceiverId.size()) {
+        if (pc == nullptr) {
+          result->Error(
+              "rtpTransceiverGetCurrentDirection",
+              "rtpTransceiverGetCurrentDirection() direction is null or empty");
+          return;
+        }
+      }
 
-  } else if (method_call.method_name().compare("createLocalMediaStream") == 0) {
-    CreateLocalMediaStream(std::move(result));
-  } else if (method_call.method_name().compare("canInsertDtmf") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+      RtpTransceiverSetDirection(pc, rtpTransceiverId, direction,
+                                 std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
+    case Method::kSetConfiguration: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("setConfiguration",
+                      "setConfiguration() peerConnection is null");
+        return;
+      }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("canInsertDtmf", "canInsertDtmf() peerConnection is null");
-      return;
+      const EncodableMap configuration = findMap(params, "configuration");
+      if (0 < configuration.size()) {
+        if (pc == nullptr) {
+          result->Error("setConfiguration",
+                        "setConfiguration() configuration is null or empty");
+          return;
+        }
+      }
+      SetConfiguration(pc, configuration, std::move(result));
+      break;
     }
+    case Method::kCaptureFrame: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
 
-    auto rtpSender = GetRtpSenderById(pc, rtpSenderId);
+      // An empty path returns the encoded bytes instead of writing a file.
+      const std::string path = findString(params, "path");
+      const std::string format = findString(params, "format");
 
-    if (rtpSender == nullptr) {
-      result->Error("sendDtmf", "sendDtmf() rtpSender is null");
-      return;
+      const std::string trackId = findString(params, "trackId");
+      scoped_refptr<RTCMediaTrack> track = MediaTrackForId(trackId);
+      if (nullptr == track) {
+        result->Error("captureFrame", "captureFrame() track is null");
+        return;
+      }
+      std::string kind = track->kind().std_string();
+      if (0 != kind.compare("video")) {
+        result->Error("captureFrame",
+                      "captureFrame() track not is video track");
+        return;
+      }
+      CaptureFrame(static_cast<RTCVideoTrack*>(track.get()), path, format,
+                   std::move(result));
+      break;
     }
-    auto dtmfSender = rtpSender->dtmf_sender();
-    bool canInsertDtmf = dtmfSender->CanInsertDtmf();
-
-    result->Success(EncodableValue(canInsertDtmf));
-  } else if (method_call.method_name().compare("sendDtmf") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+    case Method::kCreateLocalMediaStream: {
+      CreateLocalMediaStream(std::move(result));
+      break;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    const std::string tone = findString(params, "tone");
-    int duration = findInt(params, "duration");
-    int gap = findInt(params, "gap");
+    case Method::kCanInsertDtmf: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const std::string rtpSenderId = findString(params, "rtpSenderId");
+
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("canInsertDtmf",
+                      "canInsertDtmf() peerConnection is null");
+        return;
+      }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("sendDtmf", "sendDtmf() peerConnection is null");
-      return;
-    }
+      auto rtpSender = GetRtpSenderById(pc, rtpSenderId);
 
-    auto rtpSender = GetRtpSenderById(pc, rtpSenderId);
+      if (rtpSender == nullptr) {
+        result->Error("sendDtmf", "sendDtmf() rtpSender is null");
+        return;
+      }
+      auto dtmfSender = rtpSender->dtmf_sender();
+      bool canInsertDtmf = dtmfSender->CanInsertDtmf();
 
-    if (rtpSender == nullptr) {
-      result->Error("sendDtmf", "sendDtmf() rtpSender is null");
-      return;
+      result->Success(EncodableValue(canInsertDtmf));
+      break;
     }
+    case Method::kSendDtmf: {
+      if (!method_call.arguments()) {
+        result->Error("Bad Arguments", "Null constraints arguments received");
+        return;
+      }
+      const EncodableMap params =
+          GetValue<EncodableMap>(*method_call.arguments());
+      const std::string peerConnectionId =
+          findString(params, "peerConnectionId");
+      const std::string rtpSenderId = findString(params, "rtpSenderId");
+      const std::string tone = findString(params, "tone");
+      int duration = findInt(params, "duration");
+      int gap = findInt(params, "gap");
+
+      scoped_refptr<RTCPeerConnection> pc =
+          PeerConnectionForId(peerConnectionId);
+      if (pc == nullptr) {
+        result->Error("sendDtmf", "sendDtmf() peerConnection is null");
+        return;
+      }
 
-    auto dtmfSender = rtpSender->dtmf_sender();
-    dtmfSender->InsertDtmf(tone, duration, gap);
+      auto rtpSender = GetRtpSenderById(pc, rtpSenderId);
 
-    result->Success();
-  } else {
-    result->NotImplemented();
+      if (rtpSender == nullptr) {
+        result->Error("sendDtmf", "sendDtmf() rtpSender is null");
+        return;
+      }
+
+      auto dtmfSender = rtpSender->dtmf_sender();
+      dtmfSender->InsertDtmf(tone, duration, gap);
+
+      result->Success();
+      break;
+    }
   }
 }
 
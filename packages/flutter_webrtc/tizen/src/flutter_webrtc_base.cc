@@ -19,7 +19,8 @@ FlutterWebRTCBase::FlutterWebRTCBase(BinaryMessenger *messenger,
   factory_ = LibWebRTC::CreateRTCPeerConnectionFactory();
   audio_device_ = factory_->GetAudioDevice();
   video_device_ = factory_->GetVideoDevice();
-  event_channel_ = EventChannelProxy::Create(messenger_, kEventChannelName);
+  event_channel_ = EventChannelProxy::Create(messenger_, kEventChannelName,
+                                             EventChannelProxy::kUnbounded);
 }
 
 FlutterWebRTCBase::~FlutterWebRTCBase() { LibWebRTC::Terminate(); }
@@ -32,74 +33,140 @@ std::string FlutterWebRTCBase::GenerateUUID() {
   return uuidxx::uuid::Generate().ToString(false);
 }
 
-RTCPeerConnection *FlutterWebRTCBase::PeerConnectionForId(
+scoped_refptr<RTCPeerConnection> FlutterWebRTCBase::PeerConnectionForId(
     const std::string &id) {
+  std::shared_lock<std::shared_mutex> lock(peerconnections_mutex_);
   auto it = peerconnections_.find(id);
 
-  if (it != peerconnections_.end()) return (*it).second.get();
+  if (it != peerconnections_.end()) return (*it).second;
 
   return nullptr;
 }
 
-void FlutterWebRTCBase::RemovePeerConnectionForId(const std::string &id) {
-  auto it = peerconnections_.find(id);
-  if (it != peerconnections_.end()) peerconnections_.erase(it);
+void FlutterWebRTCBase::AddPeerConnection(const std::string &id,
+                                          scoped_refptr<RTCPeerConnection> pc) {
+  std::unique_lock<std::shared_mutex> lock(peerconnections_mutex_);
+  peerconnections_[id] = pc;
 }
 
-RTCMediaTrack *FlutterWebRTCBase ::MediaTrackForId(const std::string &id) {
-  auto it = local_tracks_.find(id);
-
-  if (it != local_tracks_.end()) return (*it).second.get();
-
-  for (auto kv : peerconnection_observers_) {
-    auto pco = kv.second.get();
-    auto track = pco->MediaTrackForId(id);
-    if (track != nullptr) return track;
+void FlutterWebRTCBase::RemovePeerConnectionForId(const std::string &id) {
+  // Released outside the lock.
+  scoped_refptr<RTCPeerConnection> pc;
+  {
+    std::unique_lock<std::shared_mutex> lock(peerconnections_mutex_);
+    auto it = peerconnections_.find(id);
+    if (it == peerconnections_.end()) return;
+    pc = it->second;
+    peerconnections_.erase(it);
   }
+}
 
-  return nullptr;
+scoped_refptr<RTCMediaTrack> FlutterWebRTCBase::MediaTrackForId(
+    const std::string &id) {
+  return MediaTracksForId(id);
+}
+
+void FlutterWebRTCBase::AddMediaTrack(scoped_refptr<RTCMediaTrack> track) {
+  std::unique_lock<std::shared_mutex> lock(tracks_mutex_);
+  local_tracks_[track->id().std_string()] = track;
 }
 
 void FlutterWebRTCBase::RemoveMediaTrackForId(const std::string &id) {
-  auto it = local_tracks_.find(id);
-  if (it != local_tracks_.end()) local_tracks_.erase(it);
+  std::unique_lock<std::shared_mutex> lock(tracks_mutex_);
+  local_tracks_.erase(id);
 }
 
-FlutterPeerConnectionObserver *FlutterWebRTCBase::PeerConnectionObserversForId(
-    const std::string &id) {
+std::shared_ptr<FlutterPeerConnectionObserver>
+FlutterWebRTCBase::PeerConnectionObserversForId(const std::string &id) {
+  std::shared_lock<std::shared_mutex> lock(observers_mutex_);
   auto it = peerconnection_observers_.find(id);
 
-  if (it != peerconnection_observers_.end()) return (*it).second.get();
+  if (it != peerconnection_observers_.end()) return (*it).second;
 
   return nullptr;
 }
 
+std::vector<std::shared_ptr<FlutterPeerConnectionObserver>>
+FlutterWebRTCBase::PeerConnectionObservers() const {
+  std::shared_lock<std::shared_mutex> lock(observers_mutex_);
+  std::vector<std::shared_ptr<FlutterPeerConnectionObserver>> observers;
+  observers.reserve(peerconnection_observers_.size());
+  for (const auto &kv : peerconnection_observers_) {
+    observers.push_back(kv.second);
+  }
+  return observers;
+}
+
+void FlutterWebRTCBase::AddPeerConnectionObserver(
+    const std::string &id,
+    std::shared_ptr<FlutterPeerConnectionObserver> observer) {
+  std::unique_lock<std::shared_mutex> lock(observers_mutex_);
+  peerconnection_observers_[id] = std::move(observer);
+}
+
 void FlutterWebRTCBase::RemovePeerConnectionObserversForId(
     const std::string &id) {
-  auto it = peerconnection_observers_.find(id);
-  if (it != peerconnection_observers_.end())
+  // Destroyed outside the lock.
+  std::shared_ptr<FlutterPeerConnectionObserver> observer;
+  {
+    std::unique_lock<std::shared_mutex> lock(observers_mutex_);
+    auto it = peerconnection_observers_.find(id);
+    if (it == peerconnection_observers_.end()) return;
+    observer = std::move(it->second);
     peerconnection_observers_.erase(it);
+  }
+}
+
+std::shared_ptr<FlutterRTCDataChannelObserver>
+FlutterWebRTCBase::DataChannelObserverForId(const std::string &id) {
+  std::shared_lock<std::shared_mutex> lock(data_channels_mutex_);
+  auto it = data_channel_observers_.find(id);
+
+  if (it != data_channel_observers_.end()) return it->second;
+
+  return nullptr;
+}
+
+void FlutterWebRTCBase::AddDataChannelObserver(
+    const std::string &id,
+    std::shared_ptr<FlutterRTCDataChannelObserver> observer) {
+  std::unique_lock<std::shared_mutex> lock(data_channels_mutex_);
+  data_channel_observers_[id] = std::move(observer);
+}
+
+void FlutterWebRTCBase::RemoveDataChannelObserverForId(const std::string &id) {
+  // Destroyed outside the lock.
+  std::shared_ptr<FlutterRTCDataChannelObserver> observer;
+  {
+    std::unique_lock<std::shared_mutex> lock(data_channels_mutex_);
+    auto it = data_channel_observers_.find(id);
+    if (it == data_channel_observers_.end()) return;
+    observer = std::move(it->second);
+    data_channel_observers_.erase(it);
+  }
 }
 
 scoped_refptr<RTCMediaStream> FlutterWebRTCBase::MediaStreamForId(
     const std::string &id, std::string peerConnectionId /* = std::string()*/) {
-  auto it = local_streams_.find(id);
-  if (it != local_streams_.end()) {
-    return (*it).second;
+  {
+    std::shared_lock<std::shared_mutex> lock(streams_mutex_);
+    auto it = local_streams_.find(id);
+    if (it != local_streams_.end()) {
+      return (*it).second;
+    }
   }
 
   if (!peerConnectionId.empty()) {
-    auto pco = peerconnection_observers_.find(peerConnectionId);
-    if (peerconnection_observers_.end() != pco) {
-      auto stream = pco->second->MediaStreamForId(id);
+    auto pco = PeerConnectionObserversForId(peerConnectionId);
+    if (pco) {
+      auto stream = pco->MediaStreamForId(id);
       if (stream != nullptr) {
         return stream;
       }
     }
   }
 
-  for (auto kv : peerconnection_observers_) {
-    auto pco = kv.second.get();
+  for (const auto &pco : PeerConnectionObservers()) {
     auto stream = pco->MediaStreamForId(id);
     if (stream != nullptr) return stream;
   }
@@ -107,9 +174,26 @@ scoped_refptr<RTCMediaStream> FlutterWebRTCBase::MediaStreamForId(
   return nullptr;
 }
 
+void FlutterWebRTCBase::AddMediaStream(const std::string &id,
+                                       scoped_refptr<RTCMediaStream> stream) {
+  std::unique_lock<std::shared_mutex> lock(streams_mutex_);
+  local_streams_[id] = stream;
+}
+
 void FlutterWebRTCBase::RemoveStreamForId(const std::string &id) {
-  auto it = local_streams_.find(id);
-  if (it != local_streams_.end()) local_streams_.erase(it);
+  std::unique_lock<std::shared_mutex> lock(streams_mutex_);
+  local_streams_.erase(id);
+}
+
+std::vector<scoped_refptr<RTCMediaStream>>
+FlutterWebRTCBase::LocalMediaStreams() {
+  std::shared_lock<std::shared_mutex> lock(streams_mutex_);
+  std::vector<scoped_refptr<RTCMediaStream>> streams;
+  streams.reserve(local_streams_.size());
+  for (const auto &kv : local_streams_) {
+    streams.push_back(kv.second);
+  }
+  return streams;
 }
 
 bool FlutterWebRTCBase::ParseConstraints(const EncodableMap &constraints,
@@ -297,13 +381,15 @@ bool FlutterWebRTCBase::ParseRTCConfiguration(const EncodableMap &map,
 
 scoped_refptr<RTCMediaTrack> FlutterWebRTCBase::MediaTracksForId(
     const std::string &id) {
-  auto it = local_tracks_.find(id);
-  if (it != local_tracks_.end()) {
-    return (*it).second;
+  {
+    std::shared_lock<std::shared_mutex> lock(tracks_mutex_);
+    auto it = local_tracks_.find(id);
+    if (it != local_tracks_.end()) {
+      return (*it).second;
+    }
   }
 
-  for (auto it2 : peerconnection_observers_) {
-    auto pco = it2.second;
+  for (const auto &pco : PeerConnectionObservers()) {
     auto t = pco->MediaTrackForId(id);
     if (t != nullptr) {
       return t;
@@ -314,8 +400,8 @@ scoped_refptr<RTCMediaTrack> FlutterWebRTCBase::MediaTracksForId(
 }
 
 void FlutterWebRTCBase::RemoveTracksForId(const std::string &id) {
-  auto it = local_tracks_.find(id);
-  if (it != local_tracks_.end()) local_tracks_.erase(it);
+  std::unique_lock<std::shared_mutex> lock(tracks_mutex_);
+  local_tracks_.erase(id);
 }
 
 }  // namespace flutter_webrtc_plugin
@@ -0,0 +1,129 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "video_buffer_pool.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "log.h"
+
+namespace flutter_webrtc_plugin {
+
+VideoBufferUnit::VideoBufferUnit() {
+  gpu_surface_.release_callback = &VideoBufferUnit::OnReleased;
+  gpu_surface_.release_context = this;
+}
+
+VideoBufferUnit::~VideoBufferUnit() {
+  if (tbm_surface_) {
+    tbm_surface_destroy(tbm_surface_);
+    tbm_surface_ = nullptr;
+  }
+}
+
+bool VideoBufferUnit::Write(libwebrtc::RTCVideoFrame *frame) {
+  int32_t width = frame->width();
+  int32_t height = frame->height();
+  if (!tbm_surface_ || width_ != width || height_ != height) {
+    if (tbm_surface_) {
+      tbm_surface_destroy(tbm_surface_);
+    }
+    tbm_surface_ = tbm_surface_create(width, height, TBM_FORMAT_NV12);
+    if (!tbm_surface_) {
+      LOG_ERROR("Failed to create a tbm surface of %d x %d.", width, height);
+      width_ = 0;
+      height_ = 0;
+      return false;
+    }
+    width_ = width;
+    height_ = height;
+    gpu_surface_.handle = tbm_surface_;
+    gpu_surface_.width = width_;
+    gpu_surface_.height = height_;
+    gpu_surface_.visible_width = width_;
+    gpu_surface_.visible_height = height_;
+  }
+
+  tbm_surface_info_s info;
+  if (tbm_surface_map(tbm_surface_, TBM_SURF_OPTION_WRITE, &info) !=
+      TBM_SURFACE_ERROR_NONE) {
+    LOG_ERROR("Failed to map a tbm surface.");
+    return false;
+  }
+
+  const uint8_t *src_y = frame->DataY();
+  for (int32_t y = 0; y < height; y++) {
+    std::memcpy(info.planes[0].ptr + y * info.planes[0].stride,
+                src_y + y * frame->StrideY(), width);
+  }
+
+  // Interleave the U and V planes into the UV plane of NV12.
+  const uint8_t *src_u = frame->DataU();
+  const uint8_t *src_v = frame->DataV();
+  int32_t chroma_width = (width + 1) / 2;
+  int32_t chroma_height = (height + 1) / 2;
+  for (int32_t y = 0; y < chroma_height; y++) {
+    const uint8_t *row_u = src_u + y * frame->StrideU();
+    const uint8_t *row_v = src_v + y * frame->StrideV();
+    uint8_t *row_uv = info.planes[1].ptr + y * info.planes[1].stride;
+    for (int32_t x = 0; x < chroma_width; x++) {
+      row_uv[x * 2] = row_u[x];
+      row_uv[x * 2 + 1] = row_v[x];
+    }
+  }
+
+  tbm_surface_unmap(tbm_surface_);
+  return true;
+}
+
+void VideoBufferUnit::OnReleased(void *release_context) {
+  auto *buffer = static_cast<VideoBufferUnit *>(release_context);
+  if (buffer->hold_count_.fetch_sub(1) <= 0) {
+    LOG_ERROR("Released a buffer that is not held by the engine.");
+    buffer->hold_count_ = 0;
+  }
+}
+
+VideoBufferPool::VideoBufferPool(size_t pool_size) {
+  for (size_t index = 0; index < pool_size; index++) {
+    pool_.emplace_back(std::make_unique<VideoBufferUnit>());
+  }
+}
+
+bool VideoBufferPool::IsSupported() {
+  uint32_t *formats = nullptr;
+  uint32_t format_count = 0;
+  if (tbm_surface_query_formats(&formats, &format_count) !=
+      TBM_SURFACE_ERROR_NONE) {
+    return false;
+  }
+  bool is_supported = false;
+  for (uint32_t index = 0; index < format_count; index++) {
+    if (formats[index] == TBM_FORMAT_NV12) {
+      is_supported = true;
+      break;
+    }
+  }
+  free(formats);
+  return is_supported;
+}
+
+VideoBufferUnit *VideoBufferPool::GetAvailableBuffer() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &buffer : pool_) {
+    if (!buffer->is_used_ && buffer->hold_count_ == 0) {
+      buffer->is_used_ = true;
+      return buffer.get();
+    }
+  }
+  return nullptr;
+}
+
+void VideoBufferPool::Release(VideoBufferUnit *buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer->is_used_ = false;
+}
+
+}  // namespace flutter_webrtc_plugin
@@ -0,0 +1,158 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "video_frame_converter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define HAS_NEON_ROW_KERNEL
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define HAS_SSE2_ROW_KERNEL
+#endif
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+// BT.601 limited range coefficients in 6-bit fixed point.
+constexpr int kYScale = 74;   // 1.164
+constexpr int kVToR = 102;    // 1.596
+constexpr int kUToG = 25;     // 0.391
+constexpr int kVToG = 52;     // 0.813
+constexpr int kUToB = 129;    // 2.018
+
+// Branchless, since branches on pixel values mispredict on detailed content.
+inline uint8_t Clamp(int value) {
+  return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+}
+
+inline void ConvertPixel(uint8_t y, uint8_t u, uint8_t v, uint8_t *dst) {
+  int luma = (y > 16 ? y - 16 : 0) * kYScale;
+  int cb = u - 128;
+  int cr = v - 128;
+  dst[0] = Clamp((luma + kVToR * cr) >> 6);
+  dst[1] = Clamp((luma - kUToG * cb - kVToG * cr) >> 6);
+  dst[2] = Clamp((luma + kUToB * cb) >> 6);
+  dst[3] = 0xff;
+}
+
+// Converts a full resolution row. |src_u| and |src_v| hold (width + 1) / 2
+// samples.
+void ConvertRow(const uint8_t *src_y, const uint8_t *src_u,
+                const uint8_t *src_v, uint8_t *dst, int width) {
+  int x = 0;
+#if defined(HAS_NEON_ROW_KERNEL)
+  const uint8x8_t y_offset = vdup_n_u8(16);
+  const uint8x8_t uv_offset = vdup_n_u8(128);
+  const uint8x8_t alpha = vdup_n_u8(0xff);
+  for (; x + 16 <= width; x += 16) {
+    uint8x16_t y = vld1q_u8(src_y + x);
+    uint8x8_t u8 = vld1_u8(src_u + x / 2);
+    uint8x8_t v8 = vld1_u8(src_v + x / 2);
+    // Duplicate each chroma sample for the two pixels it covers.
+    uint8x8x2_t u = vzip_u8(u8, u8);
+    uint8x8x2_t v = vzip_u8(v8, v8);
+    uint8x8_t y_halves[2] = {vget_low_u8(y), vget_high_u8(y)};
+    for (int i = 0; i < 2; i++) {
+      int16x8_t luma = vreinterpretq_s16_u16(
+          vmull_u8(vqsub_u8(y_halves[i], y_offset), vdup_n_u8(kYScale)));
+      int16x8_t cb = vreinterpretq_s16_u16(vsubl_u8(u.val[i], uv_offset));
+      int16x8_t cr = vreinterpretq_s16_u16(vsubl_u8(v.val[i], uv_offset));
+      int16x8_t r = vqaddq_s16(luma, vmulq_n_s16(cr, kVToR));
+      int16x8_t g = vqsubq_s16(
+          vqsubq_s16(luma, vmulq_n_s16(cb, kUToG)), vmulq_n_s16(cr, kVToG));
+      int16x8_t b = vqaddq_s16(luma, vmulq_n_s16(cb, kUToB));
+      uint8x8x4_t rgba;
+      rgba.val[0] = vqshrun_n_s16(r, 6);
+      rgba.val[1] = vqshrun_n_s16(g, 6);
+      rgba.val[2] = vqshrun_n_s16(b, 6);
+      rgba.val[3] = alpha;
+      vst4_u8(dst + (x + i * 8) * 4, rgba);
+    }
+  }
+#elif defined(HAS_SSE2_ROW_KERNEL)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i y_offset = _mm_set1_epi8(16);
+  const __m128i uv_offset = _mm_set1_epi16(128);
+  const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xff));
+  for (; x + 8 <= width; x += 8) {
+    int32_t u_bytes, v_bytes;
+    std::memcpy(&u_bytes, src_u + x / 2, sizeof(u_bytes));
+    std::memcpy(&v_bytes, src_v + x / 2, sizeof(v_bytes));
+    __m128i y = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src_y + x));
+    __m128i u = _mm_cvtsi32_si128(u_bytes);
+    __m128i v = _mm_cvtsi32_si128(v_bytes);
+    u = _mm_unpacklo_epi8(u, u);
+    v = _mm_unpacklo_epi8(v, v);
+
+    __m128i luma = _mm_mullo_epi16(
+        _mm_unpacklo_epi8(_mm_subs_epu8(y, y_offset), zero),
+        _mm_set1_epi16(kYScale));
+    __m128i cb = _mm_sub_epi16(_mm_unpacklo_epi8(u, zero), uv_offset);
+    __m128i cr = _mm_sub_epi16(_mm_unpacklo_epi8(v, zero), uv_offset);
+    __m128i r =
+        _mm_adds_epi16(luma, _mm_mullo_epi16(cr, _mm_set1_epi16(kVToR)));
+    __m128i g = _mm_subs_epi16(
+        _mm_subs_epi16(luma, _mm_mullo_epi16(cb, _mm_set1_epi16(kUToG))),
+        _mm_mullo_epi16(cr, _mm_set1_epi16(kVToG)));
+    __m128i b =
+        _mm_adds_epi16(luma, _mm_mullo_epi16(cb, _mm_set1_epi16(kUToB)));
+    r = _mm_packus_epi16(_mm_srai_epi16(r, 6), zero);
+    g = _mm_packus_epi16(_mm_srai_epi16(g, 6), zero);
+    b = _mm_packus_epi16(_mm_srai_epi16(b, 6), zero);
+
+    __m128i rg = _mm_unpacklo_epi8(r, g);
+    __m128i ba = _mm_unpacklo_epi8(b, alpha);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4),
+                     _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4 + 16),
+                     _mm_unpackhi_epi16(rg, ba));
+  }
+#endif
+  for (; x < width; x++) {
+    ConvertPixel(src_y[x], src_u[x / 2], src_v[x / 2], dst + x * 4);
+  }
+}
+
+}  // namespace
+
+void ConvertI420ToRgba(const uint8_t *src_y, int stride_y,
+                       const uint8_t *src_u, int stride_u,
+                       const uint8_t *src_v, int stride_v, int src_width,
+                       int src_height, uint8_t *dst, int dst_width,
+                       int dst_height) {
+  if (dst_width == src_width && dst_height == src_height) {
+    for (int y = 0; y < src_height; y++) {
+      ConvertRow(src_y + y * stride_y, src_u + (y / 2) * stride_u,
+                 src_v + (y / 2) * stride_v, dst + y * dst_width * 4,
+                 src_width);
+    }
+    return;
+  }
+
+  std::vector<int> source_x(dst_width);
+  for (int x = 0; x < dst_width; x++) {
+    source_x[x] = static_cast<int>(static_cast<int64_t>(x) * src_width /
+                                   dst_width);
+  }
+  for (int y = 0; y < dst_height; y++) {
+    int sy = static_cast<int>(static_cast<int64_t>(y) * src_height /
+                              dst_height);
+    const uint8_t *row_y = src_y + sy * stride_y;
+    const uint8_t *row_u = src_u + (sy / 2) * stride_u;
+    const uint8_t *row_v = src_v + (sy / 2) * stride_v;
+    uint8_t *row_dst = dst + y * dst_width * 4;
+    for (int x = 0; x < dst_width; x++) {
+      int sx = source_x[x];
+      ConvertPixel(row_y[sx], row_u[sx / 2], row_v[sx / 2], row_dst + x * 4);
+    }
+  }
+}
+
+}  // namespace flutter_webrtc_plugin
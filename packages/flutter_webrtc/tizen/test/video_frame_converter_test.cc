@@ -0,0 +1,188 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Host test and benchmark of ConvertI420ToRgba(). The converter has no
+// libwebrtc dependency, so this builds without the Tizen toolchain. It is not
+// part of the plugin build. From packages/flutter_webrtc/tizen, build with
+// (in one line)
+//
+//   g++ -std=c++17 -O2 -Wall -Iinc -o /tmp/converter_test
+//       test/video_frame_converter_test.cc src/video_frame_converter.cc
+//
+// and run /tmp/converter_test, with --benchmark to also time conversions.
+//
+// On x86 this checks the SSE2 kernel. Cross-compile for ARM (e.g. with
+// arm-linux-gnueabihf-g++ -mfpu=neon) and run under qemu to check the NEON
+// kernel. Every path must match the scalar reference below exactly.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "video_frame_converter.h"
+
+namespace {
+
+using flutter_webrtc_plugin::ConvertI420ToRgba;
+
+// The stride padding of each plane. It is filled with random samples like the
+// image, so reading past the end of a row shows up as a mismatch.
+constexpr int kPadding = 13;
+
+struct I420Image {
+  I420Image(int width, int height, std::mt19937 &random)
+      : width(width),
+        height(height),
+        stride_y(width + kPadding),
+        stride_uv((width + 1) / 2 + kPadding),
+        y(stride_y * height),
+        u(stride_uv * ((height + 1) / 2)),
+        v(stride_uv * ((height + 1) / 2)) {
+    for (std::vector<uint8_t> *plane : {&y, &u, &v}) {
+      for (uint8_t &sample : *plane) {
+        sample = static_cast<uint8_t>(random());
+      }
+    }
+  }
+
+  int width;
+  int height;
+  int stride_y;
+  int stride_uv;
+  std::vector<uint8_t> y;
+  std::vector<uint8_t> u;
+  std::vector<uint8_t> v;
+};
+
+uint8_t Clamp(int value) {
+  return value < 0 ? 0 : (value > 255 ? 255 : static_cast<uint8_t>(value));
+}
+
+// The BT.601 limited range conversion in 6-bit fixed point, as documented in
+// video_frame_converter.cc, with point sampling for downscaling.
+std::vector<uint8_t> Reference(const I420Image &image, int dst_width,
+                               int dst_height) {
+  std::vector<uint8_t> dst(dst_width * dst_height * 4);
+  for (int y = 0; y < dst_height; y++) {
+    int sy = static_cast<int>(static_cast<int64_t>(y) * image.height /
+                              dst_height);
+    for (int x = 0; x < dst_width; x++) {
+      int sx = static_cast<int>(static_cast<int64_t>(x) * image.width /
+                                dst_width);
+      int luma = image.y[sy * image.stride_y + sx];
+      int cb = image.u[(sy / 2) * image.stride_uv + sx / 2] - 128;
+      int cr = image.v[(sy / 2) * image.stride_uv + sx / 2] - 128;
+      luma = (luma > 16 ? luma - 16 : 0) * 74;
+      uint8_t *pixel = &dst[(y * dst_width + x) * 4];
+      pixel[0] = Clamp((luma + 102 * cr) >> 6);
+      pixel[1] = Clamp((luma - 25 * cb - 52 * cr) >> 6);
+      pixel[2] = Clamp((luma + 129 * cb) >> 6);
+      pixel[3] = 0xff;
+    }
+  }
+  return dst;
+}
+
+std::vector<uint8_t> Convert(const I420Image &image, int dst_width,
+                             int dst_height) {
+  std::vector<uint8_t> dst(dst_width * dst_height * 4);
+  ConvertI420ToRgba(image.y.data(), image.stride_y, image.u.data(),
+                    image.stride_uv, image.v.data(), image.stride_uv,
+                    image.width, image.height, dst.data(), dst_width,
+                    dst_height);
+  return dst;
+}
+
+bool Check(const I420Image &image, int dst_width, int dst_height) {
+  std::vector<uint8_t> expected = Reference(image, dst_width, dst_height);
+  std::vector<uint8_t> actual = Convert(image, dst_width, dst_height);
+  for (size_t i = 0; i < expected.size(); i++) {
+    if (expected[i] != actual[i]) {
+      size_t pixel = i / 4;
+      printf("FAILED: %dx%d -> %dx%d differs at (%zu, %zu) channel %zu: "
+             "expected %d, got %d\n",
+             image.width, image.height, dst_width, dst_height,
+             pixel % dst_width, pixel / dst_width, i % 4, expected[i],
+             actual[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RunTests() {
+  std::mt19937 random(42);
+  int failures = 0;
+  int cases = 0;
+  // Odd and even sizes around the 8 and 16 pixel kernel widths.
+  for (int width = 1; width <= 69; width++) {
+    for (int height : {1, 2, 3, 8, 9}) {
+      I420Image image(width, height, random);
+      cases++;
+      failures += !Check(image, width, height);
+    }
+  }
+  // Downscaling, including odd target sizes and a single pixel.
+  const int kSizes[][4] = {
+      {640, 480, 320, 240}, {640, 480, 213, 160}, {1280, 720, 427, 241},
+      {333, 199, 100, 61},  {70, 33, 35, 17},     {17, 9, 1, 1},
+  };
+  for (const auto &size : kSizes) {
+    I420Image image(size[0], size[1], random);
+    cases++;
+    failures += !Check(image, size[2], size[3]);
+  }
+  // The extremes of the value range, which exercise the saturation.
+  for (uint8_t value : {0, 16, 128, 235, 255}) {
+    I420Image image(37, 5, random);
+    for (std::vector<uint8_t> *plane : {&image.u, &image.v}) {
+      std::memset(plane->data(), value, plane->size());
+    }
+    cases++;
+    failures += !Check(image, image.width, image.height);
+  }
+  printf("%d of %d cases passed.\n", cases - failures, cases);
+  return failures == 0;
+}
+
+void RunBenchmark() {
+  std::mt19937 random(7);
+  const int kSizes[][4] = {
+      {1280, 720, 1280, 720},
+      {1920, 1080, 1920, 1080},
+      {1920, 1080, 640, 360},
+  };
+  constexpr int kIterations = 200;
+  for (const auto &size : kSizes) {
+    I420Image image(size[0], size[1], random);
+    std::vector<uint8_t> dst(size[2] * size[3] * 4);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; i++) {
+      ConvertI420ToRgba(image.y.data(), image.stride_y, image.u.data(),
+                        image.stride_uv, image.v.data(), image.stride_uv,
+                        image.width, image.height, dst.data(), size[2],
+                        size[3]);
+    }
+    double elapsed_us = std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    printf("%dx%d -> %dx%d: %.1f us per frame\n", size[0], size[1], size[2],
+           size[3], elapsed_us / kIterations);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (!RunTests()) {
+    return 1;
+  }
+  if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0) {
+    RunBenchmark();
+  }
+  return 0;
+}
@@ -12,6 +12,8 @@ import 'package:flutter_test/flutter_test.dart';
 import 'package:integration_test/integration_test.dart';
 import 'package:path_provider/path_provider.dart';
 import 'package:video_player/video_player.dart';
+// ignore: implementation_imports
+import 'package:video_player_tizen/src/messages.g.dart';
 
 const Duration _playDuration = Duration(seconds: 1);
 
@@ -33,7 +35,8 @@ String getUrlForAssetAsNetworkSource(String assetKey) {
 }
 
 void main() {
-  IntegrationTestWidgetsFlutterBinding.ensureInitialized();
+  final IntegrationTestWidgetsFlutterBinding binding =
+      IntegrationTestWidgetsFlutterBinding.ensureInitialized();
   late VideoPlayerController controller;
   tearDown(() async => controller.dispose());
 
@@ -202,6 +205,45 @@ void main() {
             defaultTargetPlatform == TargetPlatform.iOS);
   });
 
+  group('position polling', () {
+    const int iterations = 1000;
+
+    setUp(() {
+      controller = VideoPlayerController.asset(_videoAssetKey);
+    });
+
+    testWidgets('binary fast path matches pigeon codec',
+        (WidgetTester tester) async {
+      await controller.initialize();
+      final TizenVideoPlayerApi api = TizenVideoPlayerApi();
+      final TextureMessage message =
+          TextureMessage(textureId: controller.textureId);
+
+      final Stopwatch stopwatch = Stopwatch()..start();
+      for (int i = 0; i < iterations; i++) {
+        await api.position(message);
+      }
+      final double pigeonMicros = stopwatch.elapsedMicroseconds / iterations;
+
+      stopwatch.reset();
+      for (int i = 0; i < iterations; i++) {
+        await controller.position;
+      }
+      final double fastMicros = stopwatch.elapsedMicroseconds / iterations;
+
+      // In microseconds per call.
+      binding.reportData = <String, dynamic>{
+        ...?binding.reportData,
+        'position': <String, double>{
+          'pigeon': pigeonMicros,
+          'fast': fastMicros,
+        },
+      };
+      expect((await api.position(message)).position,
+          (await controller.position)!.inMilliseconds);
+    });
+  }, skip: kIsWeb);
+
   group('file-based videos', () {
     setUp(() async {
       // Load the data from the asset.
@@ -5,8 +5,10 @@
 #include "video_player_tizen_plugin.h"
 
 #include <app_common.h>
+#include <flutter/binary_messenger.h>
 #include <flutter/plugin_registrar.h>
 
+#include <cstring>
 #include <map>
 #include <memory>
 #include <string>
@@ -19,6 +21,13 @@
 
 namespace {
 
+// A lightweight alternative to TizenVideoPlayerApi.position, which is polled
+// frequently while a video is playing. The request is the texture ID and the
+// reply is the position in milliseconds, both as raw int64 values in host
+// byte order. An empty reply means that the caller should retry with the
+// pigeon channel to get the error details.
+constexpr char kPositionChannelName[] = "flutter.io/videoPlayerTizen/position";
+
 class VideoPlayerTizenPlugin : public flutter::Plugin,
                                public TizenVideoPlayerApi {
  public:
@@ -48,6 +57,8 @@ class VideoPlayerTizenPlugin : public flutter::Plugin,
 
  private:
   void DisposeAllPlayers();
+  void HandlePositionMessage(const uint8_t *message, size_t message_size,
+                             const flutter::BinaryReply &reply);
 
   flutter::PluginRegistrar *plugin_registrar_;
   flutter::TextureRegistrar *texture_registrar_;
@@ -67,9 +78,19 @@ VideoPlayerTizenPlugin::VideoPlayerTizenPlugin(
   texture_registrar_ = registrar->texture_registrar();
 
   TizenVideoPlayerApi::SetUp(registrar->messenger(), this);
+  registrar->messenger()->SetMessageHandler(
+      kPositionChannelName,
+      [this](const uint8_t *message, size_t message_size,
+             flutter::BinaryReply reply) {
+        HandlePositionMessage(message, message_size, reply);
+      });
 }
 
-VideoPlayerTizenPlugin::~VideoPlayerTizenPlugin() { DisposeAllPlayers(); }
+VideoPlayerTizenPlugin::~VideoPlayerTizenPlugin() {
+  plugin_registrar_->messenger()->SetMessageHandler(kPositionChannelName,
+                                                    nullptr);
+  DisposeAllPlayers();
+}
 
 void VideoPlayerTizenPlugin::DisposeAllPlayers() {
   for (const auto &[id, player] : players_) {
@@ -237,6 +258,31 @@ ErrorOr<PositionMessage> VideoPlayerTizenPlugin::Position(
   return result;
 }
 
+void VideoPlayerTizenPlugin::HandlePositionMessage(
+    const uint8_t *message, size_t message_size,
+    const flutter::BinaryReply &reply) {
+  int64_t texture_id = 0;
+  if (message_size != sizeof(texture_id)) {
+    reply(nullptr, 0);
+    return;
+  }
+  std::memcpy(&texture_id, message, sizeof(texture_id));
+
+  auto iter = players_.find(texture_id);
+  if (iter == players_.end()) {
+    reply(nullptr, 0);
+    return;
+  }
+  int64_t position = 0;
+  try {
+    position = iter->second->GetPosition();
+  } catch (const VideoPlayerError &) {
+    reply(nullptr, 0);
+    return;
+  }
+  reply(reinterpret_cast<const uint8_t *>(&position), sizeof(position));
+}
+
 void VideoPlayerTizenPlugin::SeekTo(
     const PositionMessage &msg,
     std::function<void(std::optional<FlutterError> reply)> result) {
@@ -0,0 +1,78 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:integration_test/integration_test.dart';
+// ignore: implementation_imports
+import 'package:video_player_videohole/src/messages.dart';
+import 'package:video_player_videohole/video_player.dart';
+import 'package:video_player_videohole/video_player_platform_interface.dart';
+
+const int _iterations = 1000;
+
+const int _invalidPlayerId = -1;
+
+Future<double> _measure(Future<void> Function() body) async {
+  final Stopwatch stopwatch = Stopwatch()..start();
+  for (int i = 0; i < _iterations; i++) {
+    await body();
+  }
+  return stopwatch.elapsedMicroseconds / _iterations;
+}
+
+// Compares the binary fast paths for position and setDisplayRoi against the
+// generic pigeon codec. The timings (in microseconds per call) are reported
+// through the integration test binding.
+void main() {
+  final IntegrationTestWidgetsFlutterBinding binding =
+      IntegrationTestWidgetsFlutterBinding.ensureInitialized();
+  late VideoPlayerController controller;
+
+  setUp(() async {
+    controller = VideoPlayerController.asset('assets/Butterfly-209.mp4');
+    await controller.initialize();
+  });
+
+  tearDown(() async => controller.dispose());
+
+  testWidgets('position', (WidgetTester tester) async {
+    final VideoPlayerApi api = VideoPlayerApi();
+    final PlayerMessage message =
+        PlayerMessage(playerId: controller.textureId);
+    final double pigeonMicros = await _measure(() => api.position(message));
+    final double fastMicros = await _measure(() => controller.position);
+
+    binding.reportData = <String, dynamic>{
+      ...?binding.reportData,
+      'position': <String, double>{'pigeon': pigeonMicros, 'fast': fastMicros},
+    };
+    expect((await api.position(message)).position,
+        (await controller.position)!.inMilliseconds);
+    await expectLater(
+        VideoPlayerPlatform.instance.getPosition(_invalidPlayerId),
+        throwsA(isA<PlatformException>()));
+  });
+
+  testWidgets('setDisplayRoi', (WidgetTester tester) async {
+    final VideoPlayerApi api = VideoPlayerApi();
+    final int playerId = controller.textureId;
+    final double pigeonMicros = await _measure(() => api.setDisplayRoi(
+        GeometryMessage(playerId: playerId, x: 0, y: 0, w: 640, h: 360)));
+    final double fastMicros = await _measure(() => VideoPlayerPlatform.instance
+        .setDisplayGeometry(playerId, 0, 0, 640, 360));
+
+    binding.reportData = <String, dynamic>{
+      ...?binding.reportData,
+      'setDisplayRoi': <String, double>{
+        'pigeon': pigeonMicros,
+        'fast': fastMicros,
+      },
+    };
+    await expectLater(
+        VideoPlayerPlatform.instance
+            .setDisplayGeometry(_invalidPlayerId, 0, 0, 640, 360),
+        throwsA(isA<PlatformException>()));
+  });
+}
@@ -14,6 +14,9 @@ import 'package:video_player_videohole/video_player.dart';
 
 const Duration _playDuration = Duration(seconds: 1);
 
+// A generous upper bound for switching between local streams.
+const Duration _maxZapTime = Duration(seconds: 5);
+
 // Use WebM for web to allow CI to use Chromium.
 const String _videoAssetKey =
     kIsWeb ? 'assets/Butterfly-209.webm' : 'assets/Butterfly-209.mp4';
@@ -272,6 +275,58 @@ void main() {
     );
   });
 
+  group('channel change', () {
+    late File file;
+    late HttpServer server;
+    late String httpUrl;
+
+    setUp(() async {
+      final String tempDir = (await getTemporaryDirectory()).path;
+      final ByteData bytes = await rootBundle.load(_videoAssetKey);
+      final String filename = _videoAssetKey.split('/').last;
+      file = File('$tempDir/$filename');
+      await file.writeAsBytes(bytes.buffer.asInt8List());
+
+      // Serve the same file over HTTP as a stand-in for a network stream.
+      server = await HttpServer.bind(InternetAddress.loopbackIPv4, 0);
+      server.listen((HttpRequest request) async {
+        request.response.headers.contentType = ContentType('video', 'mp4');
+        await request.response.addStream(file.openRead());
+        await request.response.close();
+      });
+      httpUrl = 'http://127.0.0.1:${server.port}/$filename';
+
+      _controller = VideoPlayerController.file(file);
+    });
+
+    tearDown(() async => server.close(force: true));
+
+    testWidgets('can switch between file and network sources',
+        (WidgetTester tester) async {
+      await _controller.initialize();
+      await _controller.setVolume(0);
+      await _controller.play();
+      await tester.pumpAndSettle(_playDuration);
+
+      final Duration toNetwork = await _controller.changeChannel(httpUrl);
+      expect(toNetwork, lessThan(_maxZapTime));
+      expect(_controller.value.isInitialized, true);
+      expect(_controller.value.duration,
+          const Duration(seconds: 7, milliseconds: 540));
+
+      await tester.pumpAndSettle(_playDuration);
+      expect(_controller.value.isPlaying, true);
+      expect(_controller.value.position,
+          (Duration position) => position > Duration.zero);
+
+      final Duration toFile =
+          await _controller.changeChannel('file://${file.path}');
+      expect(toFile, lessThan(_maxZapTime));
+      expect(_controller.value.isInitialized, true);
+      expect(_controller.value.isPlaying, true);
+    });
+  }, skip: kIsWeb);
+
   // Audio playback is tested to prevent accidental regression,
   // but could be removed in the future.
   group('asset audios', () {
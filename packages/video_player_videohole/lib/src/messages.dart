@@ -199,6 +199,123 @@ class MixWithOthersMessage {
   }
 }
 
+class GeometryAnimationMessage {
+  GeometryAnimationMessage({
+    required this.playerId,
+    required this.beginX,
+    required this.beginY,
+    required this.beginW,
+    required this.beginH,
+    required this.endX,
+    required this.endY,
+    required this.endW,
+    required this.endH,
+    required this.duration,
+  });
+
+  int playerId;
+  int beginX;
+  int beginY;
+  int beginW;
+  int beginH;
+  int endX;
+  int endY;
+  int endW;
+  int endH;
+  int duration;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['playerId'] = playerId;
+    pigeonMap['beginX'] = beginX;
+    pigeonMap['beginY'] = beginY;
+    pigeonMap['beginW'] = beginW;
+    pigeonMap['beginH'] = beginH;
+    pigeonMap['endX'] = endX;
+    pigeonMap['endY'] = endY;
+    pigeonMap['endW'] = endW;
+    pigeonMap['endH'] = endH;
+    pigeonMap['duration'] = duration;
+    return pigeonMap;
+  }
+
+  static GeometryAnimationMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return GeometryAnimationMessage(
+      playerId: pigeonMap['playerId']! as int,
+      beginX: pigeonMap['beginX']! as int,
+      beginY: pigeonMap['beginY']! as int,
+      beginW: pigeonMap['beginW']! as int,
+      beginH: pigeonMap['beginH']! as int,
+      endX: pigeonMap['endX']! as int,
+      endY: pigeonMap['endY']! as int,
+      endW: pigeonMap['endW']! as int,
+      endH: pigeonMap['endH']! as int,
+      duration: pigeonMap['duration']! as int,
+    );
+  }
+}
+
+class PrefetchMessage {
+  PrefetchMessage({
+    required this.uri,
+    required this.drmConfigs,
+    required this.pssh,
+  });
+
+  String uri;
+  Map<Object?, Object?> drmConfigs;
+  Uint8List pssh;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['uri'] = uri;
+    pigeonMap['drmConfigs'] = drmConfigs;
+    pigeonMap['pssh'] = pssh;
+    return pigeonMap;
+  }
+
+  static PrefetchMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return PrefetchMessage(
+      uri: pigeonMap['uri']! as String,
+      drmConfigs: (pigeonMap['drmConfigs'] as Map<Object?, Object?>?)!
+          .cast<Object?, Object?>(),
+      pssh: pigeonMap['pssh']! as Uint8List,
+    );
+  }
+}
+
+class ChannelMessage {
+  ChannelMessage({
+    required this.playerId,
+    required this.uri,
+    required this.drmConfigs,
+  });
+
+  int playerId;
+  String uri;
+  Map<Object?, Object?> drmConfigs;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['playerId'] = playerId;
+    pigeonMap['uri'] = uri;
+    pigeonMap['drmConfigs'] = drmConfigs;
+    return pigeonMap;
+  }
+
+  static ChannelMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return ChannelMessage(
+      playerId: pigeonMap['playerId']! as int,
+      uri: pigeonMap['uri']! as String,
+      drmConfigs: (pigeonMap['drmConfigs'] as Map<Object?, Object?>?)!
+          .cast<Object?, Object?>(),
+    );
+  }
+}
+
 class GeometryMessage {
   GeometryMessage({
     required this.playerId,
@@ -240,30 +357,39 @@ class _VideoPlayerApiCodec extends StandardMessageCodec {
   const _VideoPlayerApiCodec();
   @override
   void writeValue(WriteBuffer buffer, Object? value) {
-    if (value is CreateMessage) {
+    if (value is ChannelMessage) {
       buffer.putUint8(128);
       writeValue(buffer, value.encode());
-    } else if (value is GeometryMessage) {
+    } else if (value is CreateMessage) {
       buffer.putUint8(129);
       writeValue(buffer, value.encode());
-    } else if (value is LoopingMessage) {
+    } else if (value is GeometryAnimationMessage) {
       buffer.putUint8(130);
       writeValue(buffer, value.encode());
-    } else if (value is MixWithOthersMessage) {
+    } else if (value is GeometryMessage) {
       buffer.putUint8(131);
       writeValue(buffer, value.encode());
-    } else if (value is PlaybackSpeedMessage) {
+    } else if (value is LoopingMessage) {
       buffer.putUint8(132);
       writeValue(buffer, value.encode());
-    } else if (value is PlayerMessage) {
+    } else if (value is MixWithOthersMessage) {
       buffer.putUint8(133);
       writeValue(buffer, value.encode());
-    } else if (value is PositionMessage) {
+    } else if (value is PlaybackSpeedMessage) {
       buffer.putUint8(134);
       writeValue(buffer, value.encode());
-    } else if (value is VolumeMessage) {
+    } else if (value is PlayerMessage) {
       buffer.putUint8(135);
       writeValue(buffer, value.encode());
+    } else if (value is PositionMessage) {
+      buffer.putUint8(136);
+      writeValue(buffer, value.encode());
+    } else if (value is PrefetchMessage) {
+      buffer.putUint8(137);
+      writeValue(buffer, value.encode());
+    } else if (value is VolumeMessage) {
+      buffer.putUint8(138);
+      writeValue(buffer, value.encode());
     } else {
       super.writeValue(buffer, value);
     }
@@ -273,27 +399,36 @@ class _VideoPlayerApiCodec extends StandardMessageCodec {
   Object? readValueOfType(int type, ReadBuffer buffer) {
     switch (type) {
       case 128:
-        return CreateMessage.decode(readValue(buffer)!);
+        return ChannelMessage.decode(readValue(buffer)!);
 
       case 129:
-        return GeometryMessage.decode(readValue(buffer)!);
+        return CreateMessage.decode(readValue(buffer)!);
 
       case 130:
-        return LoopingMessage.decode(readValue(buffer)!);
+        return GeometryAnimationMessage.decode(readValue(buffer)!);
 
       case 131:
-        return MixWithOthersMessage.decode(readValue(buffer)!);
+        return GeometryMessage.decode(readValue(buffer)!);
 
       case 132:
-        return PlaybackSpeedMessage.decode(readValue(buffer)!);
+        return LoopingMessage.decode(readValue(buffer)!);
 
       case 133:
-        return PlayerMessage.decode(readValue(buffer)!);
+        return MixWithOthersMessage.decode(readValue(buffer)!);
 
       case 134:
-        return PositionMessage.decode(readValue(buffer)!);
+        return PlaybackSpeedMessage.decode(readValue(buffer)!);
 
       case 135:
+        return PlayerMessage.decode(readValue(buffer)!);
+
+      case 136:
+        return PositionMessage.decode(readValue(buffer)!);
+
+      case 137:
+        return PrefetchMessage.decode(readValue(buffer)!);
+
+      case 138:
         return VolumeMessage.decode(readValue(buffer)!);
 
       default:
@@ -610,4 +745,76 @@ class VideoPlayerApi {
       return;
     }
   }
+
+  Future<void> prefetchLicense(PrefetchMessage arg_msg) async {
+    final BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.prefetchLicense', codec,
+        binaryMessenger: _binaryMessenger);
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(<Object?>[arg_msg]) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          (replyMap['error'] as Map<Object?, Object?>?)!;
+      throw PlatformException(
+        code: (error['code'] as String?)!,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return;
+    }
+  }
+
+  Future<void> animateDisplayRoi(GeometryAnimationMessage arg_msg) async {
+    final BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.animateDisplayRoi', codec,
+        binaryMessenger: _binaryMessenger);
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(<Object?>[arg_msg]) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          (replyMap['error'] as Map<Object?, Object?>?)!;
+      throw PlatformException(
+        code: (error['code'] as String?)!,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return;
+    }
+  }
+
+  Future<void> changeChannel(ChannelMessage arg_msg) async {
+    final BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.changeChannel', codec,
+        binaryMessenger: _binaryMessenger);
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(<Object?>[arg_msg]) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          (replyMap['error'] as Map<Object?, Object?>?)!;
+      throw PlatformException(
+        code: (error['code'] as String?)!,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return;
+    }
+  }
 }
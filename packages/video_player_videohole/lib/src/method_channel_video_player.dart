@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 import 'dart:async';
+import 'dart:typed_data';
 
 import 'package:flutter/services.dart';
 import 'package:flutter/widgets.dart';
@@ -18,6 +19,17 @@ import 'messages.dart';
 class MethodChannelVideoPlayer extends VideoPlayerPlatform {
   final VideoPlayerApi _api = VideoPlayerApi();
 
+  // The position is polled and the display geometry is updated frequently,
+  // so these bypass the generic pigeon codec (a map per message) and send
+  // raw int64 values instead. An empty reply means that the request must be
+  // retried with pigeon, which reports the error.
+  static const BasicMessageChannel<ByteData> _positionChannel =
+      BasicMessageChannel<ByteData>(
+          'flutter.io/videoPlayerVideohole/position', BinaryCodec());
+  static const BasicMessageChannel<ByteData> _displayRoiChannel =
+      BasicMessageChannel<ByteData>(
+          'flutter.io/videoPlayerVideohole/displayRoi', BinaryCodec());
+
   @override
   Future<void> init() {
     return _api.initialize();
@@ -93,6 +105,11 @@ class MethodChannelVideoPlayer extends VideoPlayerPlatform {
 
   @override
   Future<Duration> getPosition(int playerId) async {
+    final ByteData request = ByteData(8)..setInt64(0, playerId, Endian.host);
+    final ByteData? reply = await _positionChannel.send(request);
+    if (reply != null && reply.lengthInBytes == 8) {
+      return Duration(milliseconds: reply.getInt64(0, Endian.host));
+    }
     final PositionMessage response =
         await _api.position(PlayerMessage(playerId: playerId));
     return Duration(milliseconds: response.position);
@@ -149,11 +166,53 @@ class MethodChannelVideoPlayer extends VideoPlayerPlatform {
   }
 
   @override
-  Future<void> setDisplayGeometry(int playerId, int x, int y, int w, int h) {
-    return _api.setDisplayRoi(
+  Future<void> setDisplayGeometry(
+      int playerId, int x, int y, int w, int h) async {
+    final ByteData request = ByteData(40)
+      ..setInt64(0, playerId, Endian.host)
+      ..setInt64(8, x, Endian.host)
+      ..setInt64(16, y, Endian.host)
+      ..setInt64(24, w, Endian.host)
+      ..setInt64(32, h, Endian.host);
+    final ByteData? reply = await _displayRoiChannel.send(request);
+    if (reply != null && reply.lengthInBytes > 0) {
+      return;
+    }
+    await _api.setDisplayRoi(
         GeometryMessage(playerId: playerId, x: x, y: y, w: w, h: h));
   }
 
+  @override
+  Future<void> animateDisplayGeometry(
+      int playerId, Rect begin, Rect end, Duration duration) {
+    return _api.animateDisplayRoi(GeometryAnimationMessage(
+      playerId: playerId,
+      beginX: begin.left.round(),
+      beginY: begin.top.round(),
+      beginW: begin.width.round(),
+      beginH: begin.height.round(),
+      endX: end.left.round(),
+      endY: end.top.round(),
+      endW: end.width.round(),
+      endH: end.height.round(),
+      duration: duration.inMilliseconds,
+    ));
+  }
+
+  @override
+  Future<void> changeChannel(
+      int playerId, String uri, Map<String, Object> drmConfigs) {
+    return _api.changeChannel(
+        ChannelMessage(playerId: playerId, uri: uri, drmConfigs: drmConfigs));
+  }
+
+  @override
+  Future<void> prefetchLicense(
+      String uri, Map<String, Object> drmConfigs, Uint8List pssh) {
+    return _api.prefetchLicense(
+        PrefetchMessage(uri: uri, drmConfigs: drmConfigs, pssh: pssh));
+  }
+
   EventChannel _eventChannelFor(int playerId) {
     return EventChannel('flutter.io/videoPlayer/videoEvents$playerId');
   }
@@ -316,6 +316,7 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
   Timer? _timer;
   bool _isDisposed = false;
   Completer<void>? _creatingCompleter;
+  Completer<void>? _channelChangeCompleter;
   StreamSubscription<dynamic>? _eventSubscription;
   _VideoAppLifeCycleObserver? _lifeCycleObserver;
 
@@ -329,6 +330,63 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
   @visibleForTesting
   int get textureId => _textureId;
 
+  /// Acquires the DRM license of an upcoming video in the background.
+  ///
+  /// Call this for content that is likely to be played next (e.g. adjacent
+  /// channels in an EPG). The license is acquired into a prepared DRM
+  /// session, which is handed over to the player when a
+  /// [VideoPlayerController.network] with the same [dataSource] and
+  /// [drmConfigs] is initialized (or [changeChannel] is called with them),
+  /// even if the license is still being acquired. Only the most recent few
+  /// prefetches are kept. [pssh] must be the init data (PSSH box) of the
+  /// content as it appears in the manifest.
+  static Future<void> prefetchLicense(
+    String dataSource, {
+    required Map<String, Object> drmConfigs,
+    required Uint8List pssh,
+  }) {
+    return _videoPlayerPlatform.prefetchLicense(dataSource, drmConfigs, pssh);
+  }
+
+  /// Switches to another video without recreating the platform player.
+  ///
+  /// The display is kept and, if [drmConfigs] has the same `drmType` as the
+  /// current video, so is the DRM session, which makes zapping between live
+  /// channels much faster than disposing this controller and creating a new
+  /// one. The play state, volume and looping settings are kept. [dataSource]
+  /// of this controller is not updated.
+  ///
+  /// Completes with the time it took until the new video was initialized. If
+  /// this is called again before that, the pending call completes with a
+  /// [StateError].
+  Future<Duration> changeChannel(
+    String dataSource, {
+    Map<String, Object> drmConfigs = const <String, Object>{},
+  }) async {
+    if (_isDisposedOrNotInitialized) {
+      return Duration.zero;
+    }
+    final Stopwatch stopwatch = Stopwatch()..start();
+    _timer?.cancel();
+    _channelChangeCompleter?.completeError(
+        StateError('Superseded by another changeChannel() call.'));
+    final Completer<void> channelChangeCompleter = Completer<void>();
+    _channelChangeCompleter = channelChangeCompleter;
+    value = value.copyWith(position: Duration.zero);
+    try {
+      await _videoPlayerPlatform.changeChannel(
+          _textureId, dataSource, drmConfigs);
+    } catch (e) {
+      if (_channelChangeCompleter == channelChangeCompleter) {
+        _channelChangeCompleter = null;
+      }
+      rethrow;
+    }
+    await channelChangeCompleter.future;
+    stopwatch.stop();
+    return stopwatch.elapsed;
+  }
+
   /// Attempts to open the given [dataSource] and load metadata about the video.
   /// Get the window geometry through window_channel.
   final MethodChannel _kChannel = const MethodChannel('tizen/internal/window');
@@ -410,7 +468,12 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
             isInitialized: event.duration != null,
             errorDescription: null,
           );
-          initializingCompleter.complete(null);
+          if (_channelChangeCompleter != null) {
+            _channelChangeCompleter!.complete(null);
+            _channelChangeCompleter = null;
+          } else {
+            initializingCompleter.complete(null);
+          }
           _applyLooping();
           _applyVolume();
           _applyPlayPause();
@@ -451,6 +514,8 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
       if (!initializingCompleter.isCompleted) {
         initializingCompleter.completeError(obj);
       }
+      _channelChangeCompleter?.completeError(obj);
+      _channelChangeCompleter = null;
     }
 
     _eventSubscription = _videoPlayerPlatform
@@ -554,6 +619,30 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
     await _videoPlayerPlatform.setDisplayGeometry(texureId, x, y, w, h);
   }
 
+  /// Moves the area of the screen where the video is displayed from [begin]
+  /// to [end] over [duration].
+  ///
+  /// The rectangles are in logical pixels relative to the window. The
+  /// geometry is interpolated natively on every display refresh, so that the
+  /// video does not lag behind the UI. Animate the [VideoPlayer] widget to
+  /// the same [end] rectangle to keep the widget in sync with the video.
+  Future<void> animateDisplayGeometry(
+      Rect begin, Rect end, Duration duration) async {
+    if (_isDisposedOrNotInitialized) {
+      return;
+    }
+    final double devicePixelRatio =
+        MediaQueryData.fromWindow(WidgetsBinding.instance.window)
+            .devicePixelRatio;
+    Rect toPhysical(Rect rect) => Rect.fromLTWH(
+        rect.left * devicePixelRatio,
+        rect.top * devicePixelRatio,
+        rect.width * devicePixelRatio,
+        rect.height * devicePixelRatio);
+    await _videoPlayerPlatform.animateDisplayGeometry(
+        _textureId, toPhysical(begin), toPhysical(end), duration);
+  }
+
   Future<void> _applyPlaybackSpeed() async {
     if (_isDisposedOrNotInitialized) {
       return;
@@ -108,6 +108,26 @@ abstract class VideoPlayerPlatform extends PlatformInterface {
   Future<void> setDisplayGeometry(int playerId, int x, int y, int w, int h) {
     throw UnimplementedError('setDisplayGeometry() has not been implemented.');
   }
+
+  /// Animates the video display geometry from [begin] to [end] in physical
+  /// pixels over [duration].
+  Future<void> animateDisplayGeometry(
+      int playerId, Rect begin, Rect end, Duration duration) {
+    throw UnimplementedError(
+        'animateDisplayGeometry() has not been implemented.');
+  }
+
+  /// Switches the player to the video at [uri] without recreating it.
+  Future<void> changeChannel(
+      int playerId, String uri, Map<String, Object> drmConfigs) {
+    throw UnimplementedError('changeChannel() has not been implemented.');
+  }
+
+  /// Acquires the DRM license of the video at [uri] in the background.
+  Future<void> prefetchLicense(
+      String uri, Map<String, Object> drmConfigs, Uint8List pssh) {
+    throw UnimplementedError('prefetchLicense() has not been implemented.');
+  }
 }
 
 /// Description of the data source used to create an instance of
@@ -55,6 +55,44 @@ class MixWithOthersMessage {
   bool mixWithOthers;
 }
 
+class GeometryAnimationMessage {
+  GeometryAnimationMessage(
+      this.playerId,
+      this.beginX,
+      this.beginY,
+      this.beginW,
+      this.beginH,
+      this.endX,
+      this.endY,
+      this.endW,
+      this.endH,
+      this.duration);
+  int playerId;
+  int beginX;
+  int beginY;
+  int beginW;
+  int beginH;
+  int endX;
+  int endY;
+  int endW;
+  int endH;
+  int duration;
+}
+
+class PrefetchMessage {
+  PrefetchMessage(this.uri, this.drmConfigs, this.pssh);
+  String uri;
+  Map<Object?, Object?> drmConfigs;
+  Uint8List pssh;
+}
+
+class ChannelMessage {
+  ChannelMessage(this.playerId, this.uri, this.drmConfigs);
+  int playerId;
+  String uri;
+  Map<Object?, Object?> drmConfigs;
+}
+
 class GeometryMessage {
   GeometryMessage(this.playerId, this.x, this.y, this.w, this.h);
   int playerId;
@@ -78,4 +116,7 @@ abstract class VideoPlayerApi {
   void pause(PlayerMessage msg);
   void setMixWithOthers(MixWithOthersMessage msg);
   void setDisplayRoi(GeometryMessage arg);
+  void prefetchLicense(PrefetchMessage msg);
+  void animateDisplayRoi(GeometryAnimationMessage msg);
+  void changeChannel(ChannelMessage msg);
 }
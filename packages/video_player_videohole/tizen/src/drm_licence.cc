@@ -9,6 +9,10 @@
 #include <string.h>
 #include <strings.h>
 
+#include <map>
+#include <mutex>
+#include <string>
+
 #include "curl/curl.h"
 #include "log.h"
 
@@ -33,6 +37,18 @@
 #define MAX_POPUP_MESSAGE_LENGTH (1024)
 #define ERROR_TITLE_LICENSE_FETCHING_FAILURE "Fetching License Failed"
 
+// License responses are typically a few kilobytes, so start with buffers large
+// enough to hold most of them without growing.
+#define INITIAL_HEADER_BUF_SIZE (2 * 1024)
+#define INITIAL_BODY_BUF_SIZE (16 * 1024)
+// Upper bound of the body buffer reserved up front from Content-Length, so that
+// a bogus header cannot make us allocate an arbitrary amount. Larger bodies
+// still grow the buffer as they arrive.
+#define MAX_RESERVED_BODY_BUF_SIZE (1024 * 1024)
+
+// Upper bound of idle keep-alive handles kept for a single license server.
+#define MAX_IDLE_HANDLES_PER_SERVER (2)
+
 namespace {
 struct SDynamicBuf {
   unsigned char* data;
@@ -51,12 +67,22 @@ struct SHttpSession {
   long res_code;
 };
 
+// Idle CURL handles keyed by "scheme://host[:port]". A handle keeps its
+// connection (and TLS session) alive after a transaction, so that the next
+// request to the same license server skips the TCP and TLS handshakes.
+std::multimap<std::string, CURL*> idle_handles;
+std::mutex idle_handles_mutex;
+
 // Internal Static Functions
 static size_t ReceiveHeader(void* ptr, size_t size, size_t nmemb, void* stream);
 static size_t ReceiveBody(void* ptr, size_t size, size_t nmemb, void* stream);
 static size_t SendBody(void* ptr, size_t size, size_t nmemb, void* stream);
+static bool ReserveData(SDynamicBuf* buf, size_t capacity);
 static bool AppendData(SDynamicBuf* append_buf, const void* append_data,
                        size_t append_size);
+static void ParseResponseHeader(SHttpSession* http_session, const char* line,
+                                size_t length);
+static std::string GetServerKey(const char* http_url);
 static char* GetRedirectLocation(const char* append_headers,
                                  bool support_https);
 static struct curl_slist* CurlSlistAppend(struct curl_slist* append_list,
@@ -69,17 +95,18 @@ static struct curl_slist* SetHttpHeader(CURL* http_curl,
                                         const char* http_cookie,
                                         const char* http_header,
                                         const char* http_user_agent);
-static SHttpSession* HttpOpen(void);
-static int CbCurlProgress(void* ptr, double total_to_download,
-                          double now_downloaded, double total_to_upload,
-                          double now_uploaded);
+static SHttpSession* HttpOpen(const char* http_url);
+static int CbCurlProgress(void* ptr, curl_off_t total_to_download,
+                          curl_off_t now_downloaded, curl_off_t total_to_upload,
+                          curl_off_t now_uploaded);
 static DRM_RESULT HttpStartTransaction(
     SHttpSession* http_session, const char* http_url, const void* post_data,
     unsigned post_data_len, DrmLicenseHelper::DrmType type,
     const char* http_cookie, const char* http_soap_header,
     const char* http_header, const char* http_user_agent,
-    bool* http_cancel_request);
-static void HttpClose(SHttpSession* http_session);
+    std::atomic<bool>* http_cancel_request);
+static void HttpClose(SHttpSession* http_session, const char* http_url,
+                      bool reuse_connection);
 static void CheckCurlFail(CURLcode expr, struct curl_slist* headers);
 
 static void CheckCurlFail(CURLcode expr, struct curl_slist* headers) {
@@ -92,19 +119,33 @@ static void CheckCurlFail(CURLcode expr, struct curl_slist* headers) {
   }
 }
 
+bool ReserveData(SDynamicBuf* buf, size_t capacity) {
+  if (buf->allocated >= capacity) {
+    return true;
+  }
+  unsigned char* data =
+      reinterpret_cast<unsigned char*>(realloc(buf->data, capacity));
+  if (!data) {
+    LOG_ERROR("[DrmLicence] ReserveData : realloc fail ");
+    return false;
+  }
+  buf->data = data;
+  buf->allocated = capacity;
+  return true;
+}
+
 bool AppendData(SDynamicBuf* append_buf, const void* append_data,
                 size_t append_size) {
   size_t new_size = append_buf->size + append_size;
   if (append_buf->allocated < new_size) {
-    new_size += 1024;
-    unsigned char* buf =
-        reinterpret_cast<unsigned char*>(realloc(append_buf->data, new_size));
-    if (!buf) {
-      LOG_ERROR("[DrmLicence] AppendData : realloc fail ");
+    // Grow geometrically to keep the number of reallocations logarithmic.
+    size_t capacity = append_buf->allocated * 2;
+    if (capacity < new_size) {
+      capacity = new_size;
+    }
+    if (!ReserveData(append_buf, capacity)) {
       return false;
     }
-    append_buf->data = buf;
-    append_buf->allocated = new_size;
     LOG_DEBUG(
         "[DrmLicence] AppendData : realloc append_size(%d), size(%d) "
         "append_buf->allocated(%d)",
@@ -376,16 +417,50 @@ struct curl_slist* SetHttpHeader(CURL* http_curl,
   return headers;
 }
 
-static SHttpSession* HttpOpen(void) {
+std::string GetServerKey(const char* http_url) {
+  if (!http_url) {
+    return std::string();
+  }
+  std::string url(http_url);
+  size_t scheme_end = url.find("://");
+  size_t host_begin = scheme_end == std::string::npos ? 0 : scheme_end + 3;
+  size_t host_end = url.find('/', host_begin);
+  if (host_end == std::string::npos) {
+    return url;
+  }
+  return url.substr(0, host_end);
+}
+
+static SHttpSession* HttpOpen(const char* http_url) {
   SHttpSession* http_session = nullptr;
 
-  CURL* http_curl = curl_easy_init();
+  CURL* http_curl = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(idle_handles_mutex);
+    auto iter = idle_handles.find(GetServerKey(http_url));
+    if (iter != idle_handles.end()) {
+      http_curl = iter->second;
+      idle_handles.erase(iter);
+    }
+  }
+  if (http_curl) {
+    // Resets the options only. Live connections, the DNS cache and TLS
+    // session IDs are kept in the handle.
+    curl_easy_reset(http_curl);
+  } else {
+    http_curl = curl_easy_init();
+  }
   if (http_curl) {
     http_session =
         reinterpret_cast<SHttpSession*>(malloc(sizeof(SHttpSession)));
     if (http_session) {
       memset(http_session, 0, sizeof(SHttpSession));
       http_session->curl_handle = http_curl;
+      if (!ReserveData(&http_session->header, INITIAL_HEADER_BUF_SIZE) ||
+          !ReserveData(&http_session->body, INITIAL_BODY_BUF_SIZE)) {
+        HttpClose(http_session, nullptr, false);
+        return nullptr;
+      }
       return http_session;
     }
     curl_easy_cleanup(http_curl);
@@ -394,13 +469,12 @@ static SHttpSession* HttpOpen(void) {
   return nullptr;
 }
 
-int CbCurlProgress(void* ptr, double total_to_download, double now_downloaded,
-                   double total_to_upload, double now_uploaded) {
-  bool* http_cancel_qequest = static_cast<bool*>(ptr);
+int CbCurlProgress(void* ptr, curl_off_t total_to_download,
+                   curl_off_t now_downloaded, curl_off_t total_to_upload,
+                   curl_off_t now_uploaded) {
+  std::atomic<bool>* http_cancel_qequest = static_cast<std::atomic<bool>*>(ptr);
 
   if (http_cancel_qequest) {
-    LOG_INFO("[DrmLicence] http_cancel_qequest : (%d)", *http_cancel_qequest);
-
     if (*http_cancel_qequest) {
       LOG_INFO("[DrmLicence] %s:%d curl works canceled.", __FUNCTION__,
                __LINE__);
@@ -416,7 +490,7 @@ DRM_RESULT HttpStartTransaction(
     unsigned post_data_len, DrmLicenseHelper::DrmType type,
     const char* http_cookie, const char* http_soap_header,
     const char* http_header, const char* http_user_agent,
-    bool* http_cancel_request) {
+    std::atomic<bool>* http_cancel_request) {
   CURLcode res = CURLE_OK;
   struct curl_slist* headers = nullptr;
   CURL* http_curl = http_session->curl_handle;
@@ -443,8 +517,10 @@ DRM_RESULT HttpStartTransaction(
 
   curl_easy_setopt(http_curl, CURLOPT_VERBOSE, 0L);
 
-  // Check
-  curl_easy_setopt(http_curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_0);
+  // Connections are reused through the cached easy handles. Enable TCP
+  // keepalive probes so that an idle cached connection to a server that went
+  // away is detected.
+  curl_easy_setopt(http_curl, CURLOPT_TCP_KEEPALIVE, 1L);
 
   int soap_flag = 0;
   free(http_session->post_data);
@@ -509,9 +585,9 @@ DRM_RESULT HttpStartTransaction(
 
   res = curl_easy_setopt(http_curl, CURLOPT_NOPROGRESS, 0L);
   CheckCurlFail(res, headers);
-  res = curl_easy_setopt(http_curl, CURLOPT_PROGRESSFUNCTION, CbCurlProgress);
+  res = curl_easy_setopt(http_curl, CURLOPT_XFERINFOFUNCTION, CbCurlProgress);
   CheckCurlFail(res, headers);
-  res = curl_easy_setopt(http_curl, CURLOPT_PROGRESSDATA, http_cancel_request);
+  res = curl_easy_setopt(http_curl, CURLOPT_XFERINFODATA, http_cancel_request);
   CheckCurlFail(res, headers);
 
   res = curl_easy_setopt(http_curl, CURLOPT_HEADERFUNCTION, ReceiveHeader);
@@ -578,7 +654,6 @@ DRM_RESULT HttpStartTransaction(
       LOG_ERROR("[DrmLicence] Failed to alloc from curl.");
       return DRM_E_POINTER;
     } else if (res == CURLE_ABORTED_BY_CALLBACK) {
-      *http_cancel_request = false;
       LOG_ERROR("[DrmLicence] Network job canceled by caller.");
       return DRM_E_NETWORK_CANCELED;
     } else {
@@ -602,13 +677,22 @@ DRM_RESULT HttpStartTransaction(
   return DRM_SUCCESS;
 }
 
-void HttpClose(SHttpSession* http_session) {
+void HttpClose(SHttpSession* http_session, const char* http_url,
+               bool reuse_connection) {
   if (!http_session) {
     return;
   }
 
   if (http_session->curl_handle != nullptr) {
-    curl_easy_cleanup(http_session->curl_handle);
+    std::string server_key = GetServerKey(http_url);
+    std::unique_lock<std::mutex> lock(idle_handles_mutex);
+    if (reuse_connection && !server_key.empty() &&
+        idle_handles.count(server_key) < MAX_IDLE_HANDLES_PER_SERVER) {
+      idle_handles.emplace(server_key, http_session->curl_handle);
+    } else {
+      lock.unlock();
+      curl_easy_cleanup(http_session->curl_handle);
+    }
   }
 
   if (http_session->post_data) {
@@ -637,10 +721,30 @@ size_t ReceiveHeader(void* ptr, size_t size, size_t nmemb, void* stream) {
     if (!AppendData(&http_session->header, ptr, data_size)) {
       return 0;
     }
+    ParseResponseHeader(http_session, static_cast<const char*>(ptr),
+                        data_size);
   }
   return data_size;
 }
 
+void ParseResponseHeader(SHttpSession* http_session, const char* line,
+                         size_t length) {
+  // Header lines are not null-terminated.
+  std::string header(line, length);
+  const char* value = nullptr;
+  if (strncasecmp(header.c_str(), "Content-Length:", 15) == 0) {
+    value = header.c_str() + 15;
+    size_t content_length = strtoul(value, nullptr, 10);
+    if (content_length > MAX_RESERVED_BODY_BUF_SIZE) {
+      content_length = MAX_RESERVED_BODY_BUF_SIZE;
+    }
+    if (content_length > 0 &&
+        !ReserveData(&http_session->body, content_length)) {
+      LOG_ERROR("[DrmLicence] Failed to reserve %zu bytes.", content_length);
+    }
+  }
+}
+
 size_t ReceiveBody(void* ptr, size_t size, size_t nmemb, void* stream) {
   LOG_DEBUG("[DrmLicence] size:%d nmemb:%d", (int)size, (int)nmemb);
 
@@ -694,7 +798,7 @@ DRM_RESULT DrmLicenseHelper::DoTransactionTZ(
 
   // Redirection 3 times..
   for (int i = 0; i < 3; i++) {
-    if (!(http_session = HttpOpen())) {
+    if (!(http_session = HttpOpen(http_url))) {
       LOG_ERROR("[DrmLicence] Failed to open HTTP session.");
       break;
     }
@@ -702,7 +806,7 @@ DRM_RESULT DrmLicenseHelper::DoTransactionTZ(
     char* soap_header = nullptr;
     char* http_header = nullptr;
     char* user_agent = nullptr;
-    bool* cancel_request = nullptr;
+    std::atomic<bool>* cancel_request = nullptr;
 
     if (http_ext_ctx != nullptr) {
       if (http_ext_ctx->http_soap_header) {
@@ -717,7 +821,7 @@ DRM_RESULT DrmLicenseHelper::DoTransactionTZ(
         user_agent = http_ext_ctx->http_user_agent;
       }
 
-      cancel_request = &(http_ext_ctx->cancel_request);
+      cancel_request = http_ext_ctx->cancel_request;
     }
 
     drm_result = HttpStartTransaction(
@@ -736,7 +840,7 @@ DRM_RESULT DrmLicenseHelper::DoTransactionTZ(
       redirect_url = GetRedirectLocation(
           reinterpret_cast<const char*>(http_session->header.data), true);
 
-      HttpClose(http_session);
+      HttpClose(http_session, http_url, true);
       http_session = nullptr;
       if (!redirect_url) {
         LOG_ERROR("[DrmLicence] Failed to get redirect URL");
@@ -771,13 +875,15 @@ DRM_RESULT DrmLicenseHelper::DoTransactionTZ(
     }
   }
 
+  // A handle whose transaction failed may hold a broken or half-read
+  // connection, so it is not kept for reuse.
+  HttpClose(http_session, http_url, drm_result == DRM_SUCCESS);
+
   if (redirect_url) {
     free(redirect_url);
     redirect_url = nullptr;
   }
 
-  HttpClose(http_session);
-
   if (drm_result != DRM_SUCCESS) {
     LOG_ERROR("[DrmLicence] Failed on network transaction, drm_result : 0x%lx",
               drm_result);
@@ -785,3 +891,11 @@ DRM_RESULT DrmLicenseHelper::DoTransactionTZ(
 
   return drm_result;
 }
+
+void DrmLicenseHelper::CloseConnections() {
+  std::lock_guard<std::mutex> lock(idle_handles_mutex);
+  for (auto& entry : idle_handles) {
+    curl_easy_cleanup(entry.second);
+  }
+  idle_handles.clear();
+}
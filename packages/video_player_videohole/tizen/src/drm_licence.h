@@ -4,6 +4,9 @@
 
 #ifndef VIDEO_PLAYER_VIDEOHOLE_PLUGIN_DRM_LICENCE_H_
 #define VIDEO_PLAYER_VIDEOHOLE_PLUGIN_DRM_LICENCE_H_
+
+#include <atomic>
+
 typedef long DRM_RESULT;
 
 #define DRM_SUCCESS ((DRM_RESULT)0x00000000L)
@@ -31,13 +34,15 @@ class DrmLicenseHelper {
     char* http_soap_header;
     char* http_header;
     char* http_user_agent;
-    bool cancel_request;
+    // The transfer is aborted once this is set. May be set from another
+    // thread.
+    std::atomic<bool>* cancel_request;
 
     SExtensionCtxTZ() {
       http_soap_header = nullptr;
       http_header = nullptr;
       http_user_agent = nullptr;
-      cancel_request = false;
+      cancel_request = nullptr;
     }
   };
 
@@ -48,6 +53,9 @@ class DrmLicenseHelper {
                                     unsigned long* response_len, DrmType type,
                                     const char* http_cookie,
                                     SExtensionCtxTZ* http_ext_ctx);
+
+  // Closes the keep-alive connections held for every license server.
+  static void CloseConnections();
 };
 
 #endif  // VIDEO_PLAYER_VIDEOHOLE_PLUGIN_DRM_LICENCE_H_
@@ -0,0 +1,176 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "drm_license_client.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "log.h"
+
+namespace {
+
+constexpr size_t kWorkerCount = 2;
+
+// Prefetches may occupy all workers but one, which is left for playback.
+constexpr size_t kMaxPrefetchWorkers = kWorkerCount - 1;
+
+}  // namespace
+
+DrmLicenseClient &DrmLicenseClient::GetInstance() {
+  static DrmLicenseClient *instance = new DrmLicenseClient();
+  return *instance;
+}
+
+void DrmLicenseClient::RequestLicense(const void *owner, Priority priority,
+                                      const std::string &license_url,
+                                      DrmLicenseHelper::DrmType type,
+                                      std::vector<uint8_t> challenge,
+                                      LicenseCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (workers_.empty()) {
+      stopped_ = false;
+      for (size_t i = 0; i < kWorkerCount; i++) {
+        workers_.emplace_back(&DrmLicenseClient::Run, this);
+      }
+    }
+    Request request{owner,
+                    priority,
+                    license_url,
+                    type,
+                    std::move(challenge),
+                    std::move(callback),
+                    std::make_shared<std::atomic<bool>>(false)};
+    if (priority == Priority::kPlayback) {
+      playback_queue_.push_back(std::move(request));
+    } else {
+      prefetch_queue_.push_back(std::move(request));
+    }
+  }
+  queue_cv_.notify_all();
+}
+
+void DrmLicenseClient::CancelRequests(const void *owner) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    auto is_owned = [owner](const Request &request) {
+      return request.owner == owner;
+    };
+    playback_queue_.erase(std::remove_if(playback_queue_.begin(),
+                                         playback_queue_.end(), is_owned),
+                          playback_queue_.end());
+    prefetch_queue_.erase(std::remove_if(prefetch_queue_.begin(),
+                                         prefetch_queue_.end(), is_owned),
+                          prefetch_queue_.end());
+    for (Request *request : active_requests_) {
+      if (request->owner == owner) {
+        // Aborts the transfer and drops its result.
+        *request->cancelled = true;
+      }
+    }
+  }
+  // Wait for a callback that has already started.
+  std::lock_guard<std::mutex> lock(callback_mutex_);
+}
+
+void DrmLicenseClient::PromoteRequests(const void *owner) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    auto iter = prefetch_queue_.begin();
+    while (iter != prefetch_queue_.end()) {
+      if (iter->owner == owner) {
+        iter->priority = Priority::kPlayback;
+        playback_queue_.push_back(std::move(*iter));
+        iter = prefetch_queue_.erase(iter);
+      } else {
+        iter++;
+      }
+    }
+  }
+  queue_cv_.notify_all();
+}
+
+void DrmLicenseClient::Shutdown() {
+  std::vector<std::thread> workers;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stopped_ = true;
+    playback_queue_.clear();
+    prefetch_queue_.clear();
+    for (Request *request : active_requests_) {
+      *request->cancelled = true;
+    }
+    workers.swap(workers_);
+  }
+  queue_cv_.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  DrmLicenseHelper::CloseConnections();
+}
+
+bool DrmLicenseClient::HasRunnableRequest() const {
+  return !playback_queue_.empty() ||
+         (!prefetch_queue_.empty() &&
+          active_prefetch_count_ < kMaxPrefetchWorkers);
+}
+
+void DrmLicenseClient::Run() {
+  while (true) {
+    Request request;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this] { return stopped_ || HasRunnableRequest(); });
+      if (stopped_) {
+        return;
+      }
+      if (!playback_queue_.empty()) {
+        request = std::move(playback_queue_.front());
+        playback_queue_.pop_front();
+      } else {
+        request = std::move(prefetch_queue_.front());
+        prefetch_queue_.pop_front();
+        active_prefetch_count_++;
+      }
+      active_requests_.push_back(&request);
+    }
+    Process(request);
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      active_requests_.erase(std::find(active_requests_.begin(),
+                                       active_requests_.end(), &request));
+      if (request.priority == Priority::kPrefetch) {
+        active_prefetch_count_--;
+      }
+    }
+    queue_cv_.notify_all();
+  }
+}
+
+void DrmLicenseClient::Process(Request &request) {
+  std::vector<uint8_t> license;
+  unsigned char *response = nullptr;
+  unsigned long response_len = 0;
+  DrmLicenseHelper::SExtensionCtxTZ ext_ctx;
+  ext_ctx.cancel_request = request.cancelled.get();
+  DRM_RESULT result = DrmLicenseHelper::DoTransactionTZ(
+      request.license_url.c_str(), request.challenge.data(),
+      static_cast<unsigned long>(request.challenge.size()), &response,
+      &response_len, request.type, nullptr, &ext_ctx);
+  LOG_INFO("[DrmLicenseClient] drm_result: 0x%lx, response_len: %lu", result,
+           response_len);
+  if (result == DRM_SUCCESS && response) {
+    license.assign(response, response + response_len);
+  }
+  free(response);
+
+  std::lock_guard<std::mutex> lock(callback_mutex_);
+  if (*request.cancelled) {
+    LOG_INFO("[DrmLicenseClient] drop the result of a cancelled request");
+    return;
+  }
+  request.callback(result, license);
+}
@@ -0,0 +1,97 @@
+// Copyright 2022 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef VIDEO_PLAYER_VIDEOHOLE_PLUGIN_DRM_LICENSE_CLIENT_H_
+#define VIDEO_PLAYER_VIDEOHOLE_PLUGIN_DRM_LICENSE_CLIENT_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "drm_licence.h"
+
+// Acquires DRM licenses on a small pool of worker threads.
+//
+// The HTTP transactions go through DrmLicenseHelper::DoTransactionTZ, which
+// keeps connections to each license server alive between requests. Requests
+// of players being played are always served before prefetch requests, and
+// one worker is reserved for them so that slow prefetches cannot delay a
+// channel change.
+class DrmLicenseClient {
+ public:
+  using LicenseCallback = std::function<void(
+      DRM_RESULT result, const std::vector<uint8_t> &license)>;
+
+  enum class Priority { kPlayback, kPrefetch };
+
+  static DrmLicenseClient &GetInstance();
+
+  DrmLicenseClient(const DrmLicenseClient &) = delete;
+  DrmLicenseClient &operator=(const DrmLicenseClient &) = delete;
+
+  // Queues a license request. |callback| is invoked on a worker thread.
+  //
+  // |owner| identifies the requester so that its requests can be cancelled
+  // with CancelRequests().
+  void RequestLicense(const void *owner, Priority priority,
+                      const std::string &license_url,
+                      DrmLicenseHelper::DrmType type,
+                      std::vector<uint8_t> challenge, LicenseCallback callback);
+
+  // Removes the queued requests of |owner| and aborts its transfers in
+  // progress. Does not wait for the network. After this returns, no callback
+  // of |owner| will be invoked. Must not be called from a callback.
+  void CancelRequests(const void *owner);
+
+  // Moves the queued prefetch requests of |owner| to the playback queue.
+  void PromoteRequests(const void *owner);
+
+  // Aborts all requests and joins the worker threads. Workers are started
+  // again by the next request.
+  void Shutdown();
+
+ private:
+  struct Request {
+    const void *owner;
+    Priority priority;
+    std::string license_url;
+    DrmLicenseHelper::DrmType type;
+    std::vector<uint8_t> challenge;
+    LicenseCallback callback;
+    std::shared_ptr<std::atomic<bool>> cancelled;
+  };
+
+  DrmLicenseClient() = default;
+  // Never destroyed: the instance is intentionally leaked so that no thread is
+  // joined during static destruction. Shutdown() releases the workers.
+  ~DrmLicenseClient() = default;
+
+  void Run();
+  bool HasRunnableRequest() const;
+  void Process(Request &request);
+
+  std::vector<std::thread> workers_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<Request> playback_queue_;
+  std::deque<Request> prefetch_queue_;
+  // The requests being processed, guarded by |queue_mutex_|.
+  std::vector<Request *> active_requests_;
+  size_t active_prefetch_count_ = 0;
+  bool stopped_ = false;
+
+  // Held while a callback runs, so that CancelRequests() can wait for a
+  // callback that has already started (a local license install, never a
+  // network round trip).
+  std::mutex callback_mutex_;
+};
+
+#endif  // VIDEO_PLAYER_VIDEOHOLE_PLUGIN_DRM_LICENSE_CLIENT_H_
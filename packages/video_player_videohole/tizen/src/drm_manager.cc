@@ -5,6 +5,7 @@
 #include "drm_manager.h"
 
 #include "drm_licence.h"
+#include "drm_license_client.h"
 #include "log.h"
 
 /**
@@ -59,7 +60,12 @@ bool DrmManager::InitializeDrmSession(const std::string &url) {
     return false;
   }
 
-  if (!SetPlayerDrm(url)) {
+  if (player_ == nullptr) {
+    // A prefetch session is not bound to any player.
+    DMGRSetData(
+        drm_session_, "set_playready_manifest",
+        const_cast<void *>(reinterpret_cast<const void *>(url.c_str())));
+  } else if (!SetPlayerDrm(url)) {
     LOG_ERROR("[DrmManager] Fail to set player drm");
     return false;
   }
@@ -80,6 +86,60 @@ bool DrmManager::InitializeDrmSession(const std::string &url) {
   return true;
 }
 
+bool DrmManager::ChangeContent(const std::string &url,
+                               const std::string &license_url) {
+  if (drm_session_ == nullptr || player_ == nullptr) {
+    return false;
+  }
+  // Drop pending license requests of the previous content.
+  DrmLicenseClient::GetInstance().CancelRequests(this);
+  license_url_ = license_url;
+  if (!SetPlayerDrm(url)) {
+    LOG_ERROR("[DrmManager] Fail to set player drm");
+    return false;
+  }
+  return true;
+}
+
+bool DrmManager::PrefetchLicense(const std::string &url,
+                                 const std::vector<uint8_t> &pssh) {
+  if (player_ != nullptr || license_url_.empty() || pssh.empty()) {
+    LOG_ERROR("[DrmManager] Invalid arguments for prefetch");
+    return false;
+  }
+  if (!InitializeDrmSession(url)) {
+    LOG_ERROR("[DrmManager] Fail to initialize prefetch session");
+    return false;
+  }
+  // Feeding the init data makes the DRM session generate a challenge, which
+  // is then handled by OnChallengeData.
+  SetDataParam_t pssh_data_param;
+  pssh_data_param.param1 = const_cast<uint8_t *>(pssh.data());
+  pssh_data_param.param2 = reinterpret_cast<void *>(pssh.size());
+  int ret = DMGRSetData(drm_session_, "update_pssh_data",
+                        reinterpret_cast<void *>(&pssh_data_param));
+  if (ret != DM_ERROR_NONE) {
+    LOG_ERROR("[DrmManager] update_pssh_data failed: %s",
+              get_error_message(ret));
+    return false;
+  }
+  return true;
+}
+
+bool DrmManager::AttachPlayer(player_h player, const std::string &url) {
+  if (drm_session_ == nullptr || player_ != nullptr || player == nullptr) {
+    return false;
+  }
+  player_ = player;
+  if (!SetPlayerDrm(url)) {
+    LOG_ERROR("[DrmManager] Fail to set player drm");
+    return false;
+  }
+  // A license request still pending now delays the start of playback.
+  DrmLicenseClient::GetInstance().PromoteRequests(this);
+  return true;
+}
+
 bool DrmManager::CreateDrmSession(void) {
   LOG_INFO("[DrmManager] drm_type_str: %s", GetDrmSubType(drm_type_).c_str());
   drm_session_ =
@@ -178,53 +238,70 @@ void DrmManager::SetLicenseData(void *response_data, size_t response_len) {
   LOG_INFO("[DrmManager] pbResponse_len: %ld", pb_response_len_);
 }
 
+bool DrmManager::InstallLicense(const std::string &session_id,
+                                const void *license, size_t license_len) {
+  SetDataParam_t license_param;
+  license_param.param1 =
+      const_cast<void *>(reinterpret_cast<const void *>(session_id.c_str()));
+  license_param.param2 = const_cast<void *>(license);
+  license_param.param3 = reinterpret_cast<void *>(license_len);
+  int ret = DMGRSetData(drm_session_, "install_eme_key",
+                        reinterpret_cast<void *>(&license_param));
+  if (ret != DM_ERROR_NONE) {
+    LOG_ERROR("[DrmManager] install_eme_key failed: %s",
+              get_error_message(ret));
+    return false;
+  }
+  return true;
+}
+
 int DrmManager::OnChallengeData(void *session_id, int msg_type, void *msg,
                                 int msg_len, void *user_data) {
   LOG_INFO("[DrmManager] session_id is [%s]", session_id);
   DrmManager *drm_manager = static_cast<DrmManager *>(user_data);
 
-  char license_url[128] = {0};
-  strcpy(license_url, drm_manager->license_url_.c_str());
   LOG_INFO("[DrmManager] drm_type_: %d", drm_manager->drm_type_);
-  LOG_INFO("[DrmManager] license_url: %s", license_url);
+  LOG_INFO("[DrmManager] license_url: %s", drm_manager->license_url_.c_str());
   LOG_INFO("[DrmManager] challenge data length: %d", msg_len);
-  std::string challenge_data(msg_len, 0);
-  memcpy(&challenge_data[0], (char *)msg, msg_len);
-  // Get the license from the DRM Server
-  SetDataParam_t *license_param =
-      reinterpret_cast<SetDataParam_t *>(malloc(sizeof(SetDataParam_t)));
+  std::string session(session_id ? static_cast<char *>(session_id) : "");
+
   if (!drm_manager->license_url_.empty()) {
     LOG_INFO("[DrmManager] get license by player");
-    DRM_RESULT drm_result = DrmLicenseHelper::DoTransactionTZ(
-        license_url, reinterpret_cast<const void *>(&challenge_data[0]),
-        static_cast<unsigned long>(challenge_data.length()), &ppb_response_,
-        &pb_response_len_,
-        static_cast<DrmLicenseHelper::DrmType>(drm_manager->drm_type_), nullptr,
-        nullptr);
-    LOG_INFO("[DrmManager] drm_result: 0x%lx", drm_result);
-    LOG_INFO("[DrmManager] ppb_response_: %s", ppb_response_);
-    LOG_INFO("[DrmManager] pbResponse_len: %ld", pb_response_len_);
-  } else {
-    LOG_INFO("[DrmManager] get license by dart callback");
-    intptr_t ret =
-        get_challenge_cb_(reinterpret_cast<uint8_t *>(&challenge_data[0]),
-                          static_cast<size_t>(challenge_data.length()));
-    if (ret == 0) {
-      LOG_ERROR("[DrmManager] request license failed");
-    }
-  }
-  license_param->param1 = session_id;
-  license_param->param2 = ppb_response_;
-  license_param->param3 = reinterpret_cast<void *>(pb_response_len_);
-  int ret = DMGRSetData(drm_manager->drm_session_, "install_eme_key",
-                        reinterpret_cast<void *>(license_param));
-  if (ret != DM_ERROR_NONE) {
-    LOG_ERROR("[DrmManager] install_eme_key failed: %s",
-              get_error_message(ret));
+    // Fetch the license on a license client's worker thread so that the DRM
+    // callback is not blocked by the network round trip. The license is
+    // installed into this session, which is where the challenge came from.
+    // A prefetch session is later handed over to the player of its content.
+    std::vector<uint8_t> challenge(static_cast<uint8_t *>(msg),
+                                   static_cast<uint8_t *>(msg) + msg_len);
+    DrmLicenseClient::GetInstance().RequestLicense(
+        drm_manager,
+        drm_manager->player_ ? DrmLicenseClient::Priority::kPlayback
+                             : DrmLicenseClient::Priority::kPrefetch,
+        drm_manager->license_url_,
+        static_cast<DrmLicenseHelper::DrmType>(drm_manager->drm_type_),
+        std::move(challenge),
+        [drm_manager, session](DRM_RESULT result,
+                               const std::vector<uint8_t> &license) {
+          if (result != DRM_SUCCESS || license.empty()) {
+            LOG_ERROR("[DrmManager] request license failed: 0x%lx", result);
+            return;
+          }
+          drm_manager->InstallLicense(session, license.data(), license.size());
+        });
+    return 0;
   }
-  if (license_param) {
-    free(license_param);
+
+  LOG_INFO("[DrmManager] get license by dart callback");
+  std::string challenge_data(msg_len, 0);
+  memcpy(&challenge_data[0], (char *)msg, msg_len);
+  intptr_t ret =
+      get_challenge_cb_(reinterpret_cast<uint8_t *>(&challenge_data[0]),
+                        static_cast<size_t>(challenge_data.length()));
+  if (ret == 0) {
+    LOG_ERROR("[DrmManager] request license failed");
   }
+  LOG_INFO("[DrmManager] pbResponse_len: %ld", pb_response_len_);
+  drm_manager->InstallLicense(session, ppb_response_, pb_response_len_);
   free(ppb_response_);
   ppb_response_ = nullptr;
 
@@ -240,6 +317,7 @@ int DrmManager::UpdatePsshDataCB(drm_init_data_type type, void *data,
   }
 
   LOG_INFO("[DrmManager] drm_session_: %p", drm_manager->drm_session_);
+
   SetDataParam_t pssh_data_param;
   pssh_data_param.param1 = reinterpret_cast<void *>(data);
   pssh_data_param.param2 = reinterpret_cast<void *>(length);
@@ -255,6 +333,9 @@ int DrmManager::UpdatePsshDataCB(drm_init_data_type type, void *data,
 }
 
 void DrmManager::ReleaseDrmSession() {
+  // Make sure that no license callback is running against this session.
+  DrmLicenseClient::GetInstance().CancelRequests(this);
+
   if (drm_session_ != nullptr) {
     int ret = 0;
     ret = DMGRSetData(drm_session_, "Finalize", nullptr);
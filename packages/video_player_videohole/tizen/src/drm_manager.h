@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "drm_manager_service_proxy.h"
 #include "player.h"
@@ -23,6 +24,18 @@ class DrmManager {
   ~DrmManager();
   bool InitializeDrmSession(const std::string &url);
   void ReleaseDrmSession();
+  // Reuses the initialized DRM session for another content of the same DRM
+  // type. The player must be in the idle state.
+  bool ChangeContent(const std::string &url, const std::string &license_url);
+  // Acquires the license of |url| in the background into a session that is
+  // not bound to a player yet. This instance must have been created with a
+  // null player.
+  bool PrefetchLicense(const std::string &url,
+                       const std::vector<uint8_t> &pssh);
+  // Binds a prefetch session to |player| for the content |url|, so that the
+  // player uses the license acquired (or being acquired) by PrefetchLicense.
+  bool AttachPlayer(player_h player, const std::string &url);
+  int drm_type() const { return drm_type_; }
   static void SetLicenseData(void *response_data, size_t response_len);
   static void GetChallengeData(FuncLicenseCB callback);
 
@@ -30,6 +43,8 @@ class DrmManager {
   bool CreateDrmSession(void);
   bool SetChallengeCondition();
   bool SetPlayerDrm(const std::string &url);
+  bool InstallLicense(const std::string &session_id, const void *license,
+                      size_t license_len);
   static void OnDrmManagerError(long errCode, char *errMsg, void *userData);
   static int OnChallengeData(void *session_id, int msgType, void *msg,
                              int msgLen, void *userData);
@@ -410,39 +410,281 @@ GeometryMessage::GeometryMessage(flutter::EncodableMap map) {
     h_ = *pointer_h_64;
 }
 
+/* GeometryAnimationMessage */
+
+int64_t GeometryAnimationMessage::player_id() const { return player_id_; }
+void GeometryAnimationMessage::set_player_id(int64_t value_arg) {
+  player_id_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::begin_x() const { return begin_x_; }
+void GeometryAnimationMessage::set_begin_x(int64_t value_arg) {
+  begin_x_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::begin_y() const { return begin_y_; }
+void GeometryAnimationMessage::set_begin_y(int64_t value_arg) {
+  begin_y_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::begin_w() const { return begin_w_; }
+void GeometryAnimationMessage::set_begin_w(int64_t value_arg) {
+  begin_w_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::begin_h() const { return begin_h_; }
+void GeometryAnimationMessage::set_begin_h(int64_t value_arg) {
+  begin_h_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::end_x() const { return end_x_; }
+void GeometryAnimationMessage::set_end_x(int64_t value_arg) {
+  end_x_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::end_y() const { return end_y_; }
+void GeometryAnimationMessage::set_end_y(int64_t value_arg) {
+  end_y_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::end_w() const { return end_w_; }
+void GeometryAnimationMessage::set_end_w(int64_t value_arg) {
+  end_w_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::end_h() const { return end_h_; }
+void GeometryAnimationMessage::set_end_h(int64_t value_arg) {
+  end_h_ = value_arg;
+}
+
+int64_t GeometryAnimationMessage::duration() const { return duration_; }
+void GeometryAnimationMessage::set_duration(int64_t value_arg) {
+  duration_ = value_arg;
+}
+
+flutter::EncodableMap GeometryAnimationMessage::ToEncodableMap() const {
+  return flutter::EncodableMap{
+      {flutter::EncodableValue("playerId"),
+       flutter::EncodableValue(player_id_)},
+      {flutter::EncodableValue("beginX"), flutter::EncodableValue(begin_x_)},
+      {flutter::EncodableValue("beginY"), flutter::EncodableValue(begin_y_)},
+      {flutter::EncodableValue("beginW"), flutter::EncodableValue(begin_w_)},
+      {flutter::EncodableValue("beginH"), flutter::EncodableValue(begin_h_)},
+      {flutter::EncodableValue("endX"), flutter::EncodableValue(end_x_)},
+      {flutter::EncodableValue("endY"), flutter::EncodableValue(end_y_)},
+      {flutter::EncodableValue("endW"), flutter::EncodableValue(end_w_)},
+      {flutter::EncodableValue("endH"), flutter::EncodableValue(end_h_)},
+      {flutter::EncodableValue("duration"), flutter::EncodableValue(duration_)},
+  };
+}
+
+GeometryAnimationMessage::GeometryAnimationMessage() {}
+
+GeometryAnimationMessage::GeometryAnimationMessage(flutter::EncodableMap map) {
+  auto encodable_player_id = map.at(flutter::EncodableValue("playerId"));
+  if (const int32_t* pointer_player_id =
+          std::get_if<int32_t>(&encodable_player_id))
+    player_id_ = *pointer_player_id;
+  else if (const int64_t* pointer_player_id_64 =
+               std::get_if<int64_t>(&encodable_player_id))
+    player_id_ = *pointer_player_id_64;
+  auto encodable_begin_x = map.at(flutter::EncodableValue("beginX"));
+  if (const int32_t* pointer_begin_x = std::get_if<int32_t>(&encodable_begin_x))
+    begin_x_ = *pointer_begin_x;
+  else if (const int64_t* pointer_begin_x_64 =
+               std::get_if<int64_t>(&encodable_begin_x))
+    begin_x_ = *pointer_begin_x_64;
+  auto encodable_begin_y = map.at(flutter::EncodableValue("beginY"));
+  if (const int32_t* pointer_begin_y = std::get_if<int32_t>(&encodable_begin_y))
+    begin_y_ = *pointer_begin_y;
+  else if (const int64_t* pointer_begin_y_64 =
+               std::get_if<int64_t>(&encodable_begin_y))
+    begin_y_ = *pointer_begin_y_64;
+  auto encodable_begin_w = map.at(flutter::EncodableValue("beginW"));
+  if (const int32_t* pointer_begin_w = std::get_if<int32_t>(&encodable_begin_w))
+    begin_w_ = *pointer_begin_w;
+  else if (const int64_t* pointer_begin_w_64 =
+               std::get_if<int64_t>(&encodable_begin_w))
+    begin_w_ = *pointer_begin_w_64;
+  auto encodable_begin_h = map.at(flutter::EncodableValue("beginH"));
+  if (const int32_t* pointer_begin_h = std::get_if<int32_t>(&encodable_begin_h))
+    begin_h_ = *pointer_begin_h;
+  else if (const int64_t* pointer_begin_h_64 =
+               std::get_if<int64_t>(&encodable_begin_h))
+    begin_h_ = *pointer_begin_h_64;
+  auto encodable_end_x = map.at(flutter::EncodableValue("endX"));
+  if (const int32_t* pointer_end_x = std::get_if<int32_t>(&encodable_end_x))
+    end_x_ = *pointer_end_x;
+  else if (const int64_t* pointer_end_x_64 =
+               std::get_if<int64_t>(&encodable_end_x))
+    end_x_ = *pointer_end_x_64;
+  auto encodable_end_y = map.at(flutter::EncodableValue("endY"));
+  if (const int32_t* pointer_end_y = std::get_if<int32_t>(&encodable_end_y))
+    end_y_ = *pointer_end_y;
+  else if (const int64_t* pointer_end_y_64 =
+               std::get_if<int64_t>(&encodable_end_y))
+    end_y_ = *pointer_end_y_64;
+  auto encodable_end_w = map.at(flutter::EncodableValue("endW"));
+  if (const int32_t* pointer_end_w = std::get_if<int32_t>(&encodable_end_w))
+    end_w_ = *pointer_end_w;
+  else if (const int64_t* pointer_end_w_64 =
+               std::get_if<int64_t>(&encodable_end_w))
+    end_w_ = *pointer_end_w_64;
+  auto encodable_end_h = map.at(flutter::EncodableValue("endH"));
+  if (const int32_t* pointer_end_h = std::get_if<int32_t>(&encodable_end_h))
+    end_h_ = *pointer_end_h;
+  else if (const int64_t* pointer_end_h_64 =
+               std::get_if<int64_t>(&encodable_end_h))
+    end_h_ = *pointer_end_h_64;
+  auto encodable_duration = map.at(flutter::EncodableValue("duration"));
+  if (const int32_t* pointer_duration =
+          std::get_if<int32_t>(&encodable_duration))
+    duration_ = *pointer_duration;
+  else if (const int64_t* pointer_duration_64 =
+               std::get_if<int64_t>(&encodable_duration))
+    duration_ = *pointer_duration_64;
+}
+
+/* PrefetchMessage */
+
+const std::string& PrefetchMessage::uri() const { return uri_; }
+void PrefetchMessage::set_uri(std::string_view value_arg) { uri_ = value_arg; }
+
+const flutter::EncodableMap& PrefetchMessage::drm_configs() const {
+  return drm_configs_;
+}
+void PrefetchMessage::set_drm_configs(const flutter::EncodableMap& value_arg) {
+  drm_configs_ = value_arg;
+}
+
+const std::vector<uint8_t>& PrefetchMessage::pssh() const { return pssh_; }
+void PrefetchMessage::set_pssh(const std::vector<uint8_t>& value_arg) {
+  pssh_ = value_arg;
+}
+
+flutter::EncodableMap PrefetchMessage::ToEncodableMap() const {
+  return flutter::EncodableMap{
+      {flutter::EncodableValue("uri"), flutter::EncodableValue(uri_)},
+      {flutter::EncodableValue("drmConfigs"),
+       flutter::EncodableValue(drm_configs_)},
+      {flutter::EncodableValue("pssh"), flutter::EncodableValue(pssh_)},
+  };
+}
+
+PrefetchMessage::PrefetchMessage() {}
+
+PrefetchMessage::PrefetchMessage(flutter::EncodableMap map) {
+  auto encodable_uri = map.at(flutter::EncodableValue("uri"));
+  if (const std::string* pointer_uri =
+          std::get_if<std::string>(&encodable_uri)) {
+    uri_ = *pointer_uri;
+  }
+  auto encodable_drm_configs = map.at(flutter::EncodableValue("drmConfigs"));
+  if (const flutter::EncodableMap* pointer_drm_configs =
+          std::get_if<flutter::EncodableMap>(&encodable_drm_configs)) {
+    drm_configs_ = *pointer_drm_configs;
+  }
+  auto encodable_pssh = map.at(flutter::EncodableValue("pssh"));
+  if (const std::vector<uint8_t>* pointer_pssh =
+          std::get_if<std::vector<uint8_t>>(&encodable_pssh)) {
+    pssh_ = *pointer_pssh;
+  }
+}
+
+/* ChannelMessage */
+
+int64_t ChannelMessage::player_id() const { return player_id_; }
+void ChannelMessage::set_player_id(int64_t value_arg) {
+  player_id_ = value_arg;
+}
+
+const std::string& ChannelMessage::uri() const { return uri_; }
+void ChannelMessage::set_uri(std::string_view value_arg) { uri_ = value_arg; }
+
+const flutter::EncodableMap& ChannelMessage::drm_configs() const {
+  return drm_configs_;
+}
+void ChannelMessage::set_drm_configs(const flutter::EncodableMap& value_arg) {
+  drm_configs_ = value_arg;
+}
+
+flutter::EncodableMap ChannelMessage::ToEncodableMap() const {
+  return flutter::EncodableMap{
+      {flutter::EncodableValue("playerId"),
+       flutter::EncodableValue(player_id_)},
+      {flutter::EncodableValue("uri"), flutter::EncodableValue(uri_)},
+      {flutter::EncodableValue("drmConfigs"),
+       flutter::EncodableValue(drm_configs_)},
+  };
+}
+
+ChannelMessage::ChannelMessage() {}
+
+ChannelMessage::ChannelMessage(flutter::EncodableMap map) {
+  auto encodable_player_id = map.at(flutter::EncodableValue("playerId"));
+  if (const int32_t* pointer_player_id =
+          std::get_if<int32_t>(&encodable_player_id))
+    player_id_ = *pointer_player_id;
+  else if (const int64_t* pointer_player_id_64 =
+               std::get_if<int64_t>(&encodable_player_id))
+    player_id_ = *pointer_player_id_64;
+  auto encodable_uri = map.at(flutter::EncodableValue("uri"));
+  if (const std::string* pointer_uri =
+          std::get_if<std::string>(&encodable_uri)) {
+    uri_ = *pointer_uri;
+  }
+  auto encodable_drm_configs = map.at(flutter::EncodableValue("drmConfigs"));
+  if (const flutter::EncodableMap* pointer_drm_configs =
+          std::get_if<flutter::EncodableMap>(&encodable_drm_configs)) {
+    drm_configs_ = *pointer_drm_configs;
+  }
+}
+
 VideoPlayerApiCodecSerializer::VideoPlayerApiCodecSerializer() {}
 flutter::EncodableValue VideoPlayerApiCodecSerializer::ReadValueOfType(
     uint8_t type, flutter::ByteStreamReader* stream) const {
   switch (type) {
     case 128:
       return flutter::CustomEncodableValue(
-          CreateMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
+          ChannelMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
 
     case 129:
       return flutter::CustomEncodableValue(
-          GeometryMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
+          CreateMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
 
     case 130:
+      return flutter::CustomEncodableValue(GeometryAnimationMessage(
+          std::get<flutter::EncodableMap>(ReadValue(stream))));
+
+    case 131:
+      return flutter::CustomEncodableValue(
+          GeometryMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
+
+    case 132:
       return flutter::CustomEncodableValue(
           LoopingMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
 
-    case 131:
+    case 133:
       return flutter::CustomEncodableValue(MixWithOthersMessage(
           std::get<flutter::EncodableMap>(ReadValue(stream))));
 
-    case 132:
+    case 134:
       return flutter::CustomEncodableValue(PlaybackSpeedMessage(
           std::get<flutter::EncodableMap>(ReadValue(stream))));
 
-    case 133:
+    case 135:
       return flutter::CustomEncodableValue(
           PlayerMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
 
-    case 134:
+    case 136:
       return flutter::CustomEncodableValue(
           PositionMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
 
-    case 135:
+    case 137:
+      return flutter::CustomEncodableValue(
+          PrefetchMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
+
+    case 138:
       return flutter::CustomEncodableValue(
           VolumeMessage(std::get<flutter::EncodableMap>(ReadValue(stream))));
 
@@ -456,16 +698,32 @@ void VideoPlayerApiCodecSerializer::WriteValue(
     flutter::ByteStreamWriter* stream) const {
   if (const flutter::CustomEncodableValue* custom_value =
           std::get_if<flutter::CustomEncodableValue>(&value)) {
-    if (custom_value->type() == typeid(CreateMessage)) {
+    if (custom_value->type() == typeid(ChannelMessage)) {
       stream->WriteByte(128);
+      WriteValue(
+          flutter::EncodableValue(
+              std::any_cast<ChannelMessage>(*custom_value).ToEncodableMap()),
+          stream);
+      return;
+    }
+    if (custom_value->type() == typeid(CreateMessage)) {
+      stream->WriteByte(129);
       WriteValue(
           flutter::EncodableValue(
               std::any_cast<CreateMessage>(*custom_value).ToEncodableMap()),
           stream);
       return;
     }
+    if (custom_value->type() == typeid(GeometryAnimationMessage)) {
+      stream->WriteByte(130);
+      WriteValue(flutter::EncodableValue(
+                     std::any_cast<GeometryAnimationMessage>(*custom_value)
+                         .ToEncodableMap()),
+                 stream);
+      return;
+    }
     if (custom_value->type() == typeid(GeometryMessage)) {
-      stream->WriteByte(129);
+      stream->WriteByte(131);
       WriteValue(
           flutter::EncodableValue(
               std::any_cast<GeometryMessage>(*custom_value).ToEncodableMap()),
@@ -473,7 +731,7 @@ void VideoPlayerApiCodecSerializer::WriteValue(
       return;
     }
     if (custom_value->type() == typeid(LoopingMessage)) {
-      stream->WriteByte(130);
+      stream->WriteByte(132);
       WriteValue(
           flutter::EncodableValue(
               std::any_cast<LoopingMessage>(*custom_value).ToEncodableMap()),
@@ -481,7 +739,7 @@ void VideoPlayerApiCodecSerializer::WriteValue(
       return;
     }
     if (custom_value->type() == typeid(MixWithOthersMessage)) {
-      stream->WriteByte(131);
+      stream->WriteByte(133);
       WriteValue(flutter::EncodableValue(
                      std::any_cast<MixWithOthersMessage>(*custom_value)
                          .ToEncodableMap()),
@@ -489,7 +747,7 @@ void VideoPlayerApiCodecSerializer::WriteValue(
       return;
     }
     if (custom_value->type() == typeid(PlaybackSpeedMessage)) {
-      stream->WriteByte(132);
+      stream->WriteByte(134);
       WriteValue(flutter::EncodableValue(
                      std::any_cast<PlaybackSpeedMessage>(*custom_value)
                          .ToEncodableMap()),
@@ -497,7 +755,7 @@ void VideoPlayerApiCodecSerializer::WriteValue(
       return;
     }
     if (custom_value->type() == typeid(PlayerMessage)) {
-      stream->WriteByte(133);
+      stream->WriteByte(135);
       WriteValue(
           flutter::EncodableValue(
               std::any_cast<PlayerMessage>(*custom_value).ToEncodableMap()),
@@ -505,15 +763,23 @@ void VideoPlayerApiCodecSerializer::WriteValue(
       return;
     }
     if (custom_value->type() == typeid(PositionMessage)) {
-      stream->WriteByte(134);
+      stream->WriteByte(136);
       WriteValue(
           flutter::EncodableValue(
               std::any_cast<PositionMessage>(*custom_value).ToEncodableMap()),
           stream);
       return;
     }
+    if (custom_value->type() == typeid(PrefetchMessage)) {
+      stream->WriteByte(137);
+      WriteValue(
+          flutter::EncodableValue(
+              std::any_cast<PrefetchMessage>(*custom_value).ToEncodableMap()),
+          stream);
+      return;
+    }
     if (custom_value->type() == typeid(VolumeMessage)) {
-      stream->WriteByte(135);
+      stream->WriteByte(138);
       WriteValue(
           flutter::EncodableValue(
               std::any_cast<VolumeMessage>(*custom_value).ToEncodableMap()),
@@ -1043,7 +1309,132 @@ void VideoPlayerApi::SetUp(flutter::BinaryMessenger* binary_messenger,
       channel->SetMessageHandler(nullptr);
     }
   }
-}
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            binary_messenger,
+            "dev.flutter.pigeon.VideoPlayerApi.prefetchLicense", &GetCodec());
+    if (api != nullptr) {
+      channel->SetMessageHandler(
+          [api](const flutter::EncodableValue& message,
+                const flutter::MessageReply<flutter::EncodableValue>& reply) {
+            flutter::EncodableMap wrapped;
+            try {
+              auto args = std::get<flutter::EncodableList>(message);
+              auto encodable_msg_arg = args.at(0);
+              if (encodable_msg_arg.IsNull()) {
+                wrapped.insert(
+                    std::make_pair(flutter::EncodableValue("error"),
+                                   WrapError("msg_arg unexpectedly null.")));
+                reply(flutter::EncodableValue(wrapped));
+                return;
+              }
+              const PrefetchMessage& msg_arg =
+                  std::any_cast<const PrefetchMessage&>(
+                      std::get<flutter::CustomEncodableValue>(
+                          encodable_msg_arg));
+              std::optional<FlutterError> output =
+                  api->PrefetchLicense(msg_arg);
+              if (output.has_value()) {
+                wrapped.insert(std::make_pair(flutter::EncodableValue("error"),
+                                              WrapError(output.value())));
+              } else {
+                wrapped.insert(std::make_pair(flutter::EncodableValue("result"),
+                                              flutter::EncodableValue()));
+              }
+            } catch (const std::exception& exception) {
+              wrapped.insert(std::make_pair(flutter::EncodableValue("error"),
+                                            WrapError(exception.what())));
+            }
+            reply(flutter::EncodableValue(wrapped));
+          });
+    } else {
+      channel->SetMessageHandler(nullptr);
+    }
+  }  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            binary_messenger,
+            "dev.flutter.pigeon.VideoPlayerApi.animateDisplayRoi", &GetCodec());
+    if (api != nullptr) {
+      channel->SetMessageHandler(
+          [api](const flutter::EncodableValue& message,
+                const flutter::MessageReply<flutter::EncodableValue>& reply) {
+            flutter::EncodableMap wrapped;
+            try {
+              auto args = std::get<flutter::EncodableList>(message);
+              auto encodable_msg_arg = args.at(0);
+              if (encodable_msg_arg.IsNull()) {
+                wrapped.insert(
+                    std::make_pair(flutter::EncodableValue("error"),
+                                   WrapError("msg_arg unexpectedly null.")));
+                reply(flutter::EncodableValue(wrapped));
+                return;
+              }
+              const GeometryAnimationMessage& msg_arg =
+                  std::any_cast<const GeometryAnimationMessage&>(
+                      std::get<flutter::CustomEncodableValue>(
+                          encodable_msg_arg));
+              std::optional<FlutterError> output =
+                  api->AnimateDisplayRoi(msg_arg);
+              if (output.has_value()) {
+                wrapped.insert(std::make_pair(flutter::EncodableValue("error"),
+                                              WrapError(output.value())));
+              } else {
+                wrapped.insert(std::make_pair(flutter::EncodableValue("result"),
+                                              flutter::EncodableValue()));
+              }
+            } catch (const std::exception& exception) {
+              wrapped.insert(std::make_pair(flutter::EncodableValue("error"),
+                                            WrapError(exception.what())));
+            }
+            reply(flutter::EncodableValue(wrapped));
+          });
+    } else {
+      channel->SetMessageHandler(nullptr);
+    }
+  }  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            binary_messenger, "dev.flutter.pigeon.VideoPlayerApi.changeChannel",
+            &GetCodec());
+    if (api != nullptr) {
+      channel->SetMessageHandler(
+          [api](const flutter::EncodableValue& message,
+                const flutter::MessageReply<flutter::EncodableValue>& reply) {
+            flutter::EncodableMap wrapped;
+            try {
+              auto args = std::get<flutter::EncodableList>(message);
+              auto encodable_msg_arg = args.at(0);
+              if (encodable_msg_arg.IsNull()) {
+                wrapped.insert(
+                    std::make_pair(flutter::EncodableValue("error"),
+                                   WrapError("msg_arg unexpectedly null.")));
+                reply(flutter::EncodableValue(wrapped));
+                return;
+              }
+              const ChannelMessage& msg_arg =
+                  std::any_cast<const ChannelMessage&>(
+                      std::get<flutter::CustomEncodableValue>(
+                          encodable_msg_arg));
+              std::optional<FlutterError> output = api->ChangeChannel(msg_arg);
+              if (output.has_value()) {
+                wrapped.insert(std::make_pair(flutter::EncodableValue("error"),
+                                              WrapError(output.value())));
+              } else {
+                wrapped.insert(std::make_pair(flutter::EncodableValue("result"),
+                                              flutter::EncodableValue()));
+              }
+            } catch (const std::exception& exception) {
+              wrapped.insert(std::make_pair(flutter::EncodableValue("error"),
+                                            WrapError(exception.what())));
+            }
+            reply(flutter::EncodableValue(wrapped));
+          });
+    } else {
+      channel->SetMessageHandler(nullptr);
+    }
+  }}
 
 flutter::EncodableMap VideoPlayerApi::WrapError(
     std::string_view error_message) {
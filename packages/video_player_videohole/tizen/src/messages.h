@@ -14,6 +14,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <vector>
 
 /* Generated class from Pigeon. */
 
@@ -235,6 +236,103 @@ class GeometryMessage {
   int64_t h_;
 };
 
+/* Generated class from Pigeon that represents data sent in messages. */
+class GeometryAnimationMessage {
+ public:
+  GeometryAnimationMessage();
+  int64_t player_id() const;
+  void set_player_id(int64_t value_arg);
+
+  int64_t begin_x() const;
+  void set_begin_x(int64_t value_arg);
+
+  int64_t begin_y() const;
+  void set_begin_y(int64_t value_arg);
+
+  int64_t begin_w() const;
+  void set_begin_w(int64_t value_arg);
+
+  int64_t begin_h() const;
+  void set_begin_h(int64_t value_arg);
+
+  int64_t end_x() const;
+  void set_end_x(int64_t value_arg);
+
+  int64_t end_y() const;
+  void set_end_y(int64_t value_arg);
+
+  int64_t end_w() const;
+  void set_end_w(int64_t value_arg);
+
+  int64_t end_h() const;
+  void set_end_h(int64_t value_arg);
+
+  int64_t duration() const;
+  void set_duration(int64_t value_arg);
+
+ private:
+  GeometryAnimationMessage(flutter::EncodableMap map);
+  flutter::EncodableMap ToEncodableMap() const;
+  friend class VideoPlayerApi;
+  friend class VideoPlayerApiCodecSerializer;
+  int64_t player_id_;
+  int64_t begin_x_;
+  int64_t begin_y_;
+  int64_t begin_w_;
+  int64_t begin_h_;
+  int64_t end_x_;
+  int64_t end_y_;
+  int64_t end_w_;
+  int64_t end_h_;
+  int64_t duration_;
+};
+
+/* Generated class from Pigeon that represents data sent in messages. */
+class PrefetchMessage {
+ public:
+  PrefetchMessage();
+  const std::string& uri() const;
+  void set_uri(std::string_view value_arg);
+
+  const flutter::EncodableMap& drm_configs() const;
+  void set_drm_configs(const flutter::EncodableMap& value_arg);
+
+  const std::vector<uint8_t>& pssh() const;
+  void set_pssh(const std::vector<uint8_t>& value_arg);
+
+ private:
+  PrefetchMessage(flutter::EncodableMap map);
+  flutter::EncodableMap ToEncodableMap() const;
+  friend class VideoPlayerApi;
+  friend class VideoPlayerApiCodecSerializer;
+  std::string uri_;
+  flutter::EncodableMap drm_configs_;
+  std::vector<uint8_t> pssh_;
+};
+
+/* Generated class from Pigeon that represents data sent in messages. */
+class ChannelMessage {
+ public:
+  ChannelMessage();
+  int64_t player_id() const;
+  void set_player_id(int64_t value_arg);
+
+  const std::string& uri() const;
+  void set_uri(std::string_view value_arg);
+
+  const flutter::EncodableMap& drm_configs() const;
+  void set_drm_configs(const flutter::EncodableMap& value_arg);
+
+ private:
+  ChannelMessage(flutter::EncodableMap map);
+  flutter::EncodableMap ToEncodableMap() const;
+  friend class VideoPlayerApi;
+  friend class VideoPlayerApiCodecSerializer;
+  int64_t player_id_;
+  std::string uri_;
+  flutter::EncodableMap drm_configs_;
+};
+
 class VideoPlayerApiCodecSerializer : public flutter::StandardCodecSerializer {
  public:
   inline static VideoPlayerApiCodecSerializer& GetInstance() {
@@ -277,6 +375,12 @@ class VideoPlayerApi {
       const MixWithOthersMessage& msg) = 0;
   virtual std::optional<FlutterError> SetDisplayRoi(
       const GeometryMessage& arg) = 0;
+  virtual std::optional<FlutterError> PrefetchLicense(
+      const PrefetchMessage& msg) = 0;
+  virtual std::optional<FlutterError> AnimateDisplayRoi(
+      const GeometryAnimationMessage& msg) = 0;
+  virtual std::optional<FlutterError> ChangeChannel(
+      const ChannelMessage& msg) = 0;
 
   /** The codec used by VideoPlayerApi. */
   static const flutter::StandardMessageCodec& GetCodec();
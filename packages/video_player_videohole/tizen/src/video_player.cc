@@ -109,7 +109,8 @@ bool VideoPlayer::Open(const std::string &uri) {
     return false;
   }
 
-  if (drm_type_ != DRM_TYPE_NONE) {
+  drm_manager_ = TakePrefetchedDrmSession(drm_type_, uri_);
+  if (!drm_manager_ && drm_type_ != DRM_TYPE_NONE) {
     drm_manager_ =
         std::make_unique<DrmManager>(drm_type_, license_url_, player_);
     if (!drm_manager_->InitializeDrmSession(uri_)) {
@@ -127,6 +128,29 @@ bool VideoPlayer::Open(const std::string &uri) {
   return true;
 }
 
+void VideoPlayer::SetPrefetchedDrmSession(
+    std::unique_ptr<DrmManager> drm_manager) {
+  if (prefetched_drm_manager_) {
+    prefetched_drm_manager_->ReleaseDrmSession();
+  }
+  prefetched_drm_manager_ = std::move(drm_manager);
+}
+
+std::unique_ptr<DrmManager> VideoPlayer::TakePrefetchedDrmSession(
+    int drm_type, const std::string &uri) {
+  std::unique_ptr<DrmManager> drm_manager = std::move(prefetched_drm_manager_);
+  if (!drm_manager) {
+    return nullptr;
+  }
+  if (drm_manager->drm_type() == drm_type &&
+      drm_manager->AttachPlayer(player_, uri)) {
+    LOG_INFO("[VideoPlayer] use the prefetched drm session");
+    return drm_manager;
+  }
+  drm_manager->ReleaseDrmSession();
+  return nullptr;
+}
+
 bool VideoPlayer::SetDisplay(FlutterDesktopPluginRegistrarRef registrar_ref) {
   FlutterDesktopViewRef view_ref =
       FlutterDesktopPluginRegistrarGetView(registrar_ref);
@@ -185,7 +209,7 @@ int64_t VideoPlayer::Create() {
     LOG_ERROR("[VideoPlayer] fail to set display");
     return -1;
   }
-  SetDisplayRoi(0, 0, 1, 1);
+  ApplyDisplayRoi({0, 0, 1, 1});
 
   int ret = player_set_buffering_cb(player_, OnBuffering, (void *)this);
   if (ret != PLAYER_ERROR_NONE) {
@@ -244,11 +268,152 @@ int64_t VideoPlayer::Create() {
 }
 
 void VideoPlayer::SetDisplayRoi(int x, int y, int w, int h) {
-  int ret = player_set_display_roi_area(player_, x, y, w, h);
+  DisplayRoi roi = {x, y, w, h};
+  if (roi_timeline_) {
+    // The widget reports the final layout right away while an animation
+    // towards the same area is still running.
+    if (roi == roi_end_) {
+      return;
+    }
+    ecore_animator_del(roi_timeline_);
+    roi_timeline_ = nullptr;
+  }
+  pending_roi_ = roi;
+  if (!roi_animator_) {
+    roi_animator_ = ecore_animator_add(OnDisplayRoiFrame, this);
+  }
+}
+
+void VideoPlayer::AnimateDisplayRoi(int begin_x, int begin_y, int begin_w,
+                                    int begin_h, int end_x, int end_y,
+                                    int end_w, int end_h, int duration_ms) {
+  CancelDisplayRoiUpdates();
+  if (duration_ms <= 0) {
+    SetDisplayRoi(end_x, end_y, end_w, end_h);
+    return;
+  }
+  roi_begin_ = {begin_x, begin_y, begin_w, begin_h};
+  roi_end_ = {end_x, end_y, end_w, end_h};
+  ApplyDisplayRoi(roi_begin_);
+  roi_timeline_ = ecore_animator_timeline_add(
+      duration_ms / 1000.0, OnDisplayRoiAnimationFrame, this);
+}
+
+void VideoPlayer::ApplyDisplayRoi(const DisplayRoi &roi) {
+  if (roi == applied_roi_) {
+    return;
+  }
+  int ret = player_set_display_roi_area(player_, roi.x, roi.y, roi.w, roi.h);
   if (ret != PLAYER_ERROR_NONE) {
-    player_destroy(player_);
     LOG_ERROR("[VideoPlayer] player_set_display_roi_area failed: %s",
               get_error_message(ret));
+    return;
+  }
+  applied_roi_ = roi;
+}
+
+void VideoPlayer::CancelDisplayRoiUpdates() {
+  if (roi_animator_) {
+    ecore_animator_del(roi_animator_);
+    roi_animator_ = nullptr;
+  }
+  if (roi_timeline_) {
+    ecore_animator_del(roi_timeline_);
+    roi_timeline_ = nullptr;
+  }
+}
+
+Eina_Bool VideoPlayer::OnDisplayRoiFrame(void *data) {
+  VideoPlayer *player = reinterpret_cast<VideoPlayer *>(data);
+  player->roi_animator_ = nullptr;
+  player->ApplyDisplayRoi(player->pending_roi_);
+  return ECORE_CALLBACK_CANCEL;
+}
+
+Eina_Bool VideoPlayer::OnDisplayRoiAnimationFrame(void *data, double pos) {
+  VideoPlayer *player = reinterpret_cast<VideoPlayer *>(data);
+  const DisplayRoi &begin = player->roi_begin_;
+  const DisplayRoi &end = player->roi_end_;
+  auto lerp = [pos](int from, int to) {
+    return from + static_cast<int>((to - from) * pos);
+  };
+  player->ApplyDisplayRoi({lerp(begin.x, end.x), lerp(begin.y, end.y),
+                           lerp(begin.w, end.w), lerp(begin.h, end.h)});
+  if (pos >= 1.0) {
+    player->roi_timeline_ = nullptr;
+    return ECORE_CALLBACK_CANCEL;
+  }
+  return ECORE_CALLBACK_RENEW;
+}
+
+bool VideoPlayer::ChangeChannel(const std::string &uri, int drm_type,
+                                const std::string &license_url) {
+  LOG_INFO("[VideoPlayer] change channel to %s", uri.c_str());
+  channel_change_start_ = std::chrono::steady_clock::now();
+
+  int ret = player_unprepare(player_);
+  if (ret != PLAYER_ERROR_NONE) {
+    // The current content is still prepared and keeps playing.
+    LOG_ERROR("[VideoPlayer] player_unprepare failed: %s",
+              get_error_message(ret));
+    SetPrefetchedDrmSession(nullptr);
+    return false;
+  }
+  is_changing_channel_ = true;
+  is_initialized_ = false;
+
+  if (drm_manager_) {
+    // A prefetched session is preferred since it may hold the license of
+    // the new content already.
+    if (!prefetched_drm_manager_ && drm_type == drm_type_ &&
+        drm_manager_->ChangeContent(uri, license_url)) {
+      LOG_INFO("[VideoPlayer] reuse drm session");
+    } else {
+      drm_manager_->ReleaseDrmSession();
+      drm_manager_ = nullptr;
+      if (drm_type == DRM_TYPE_NONE) {
+        player_set_drm_handle(player_, PLAYER_DRM_TYPE_NONE, 0);
+      }
+    }
+  }
+  if (!drm_manager_) {
+    drm_manager_ = TakePrefetchedDrmSession(drm_type, uri);
+  }
+  if (!drm_manager_ && drm_type != DRM_TYPE_NONE) {
+    drm_manager_ = std::make_unique<DrmManager>(drm_type, license_url, player_);
+    if (!drm_manager_->InitializeDrmSession(uri)) {
+      LOG_ERROR("[VideoPlayer] initial drm session failed");
+    }
+  }
+  uri_ = uri;
+  drm_type_ = drm_type;
+  license_url_ = license_url;
+
+  ret = player_set_uri(player_, uri_.c_str());
+  if (ret != PLAYER_ERROR_NONE) {
+    LOG_ERROR("[VideoPlayer] player_set_uri failed: %s",
+              get_error_message(ret));
+    OnChannelChangeFailed(ret);
+    return false;
+  }
+  ret = player_prepare_async(player_, OnPrepared, this);
+  if (ret != PLAYER_ERROR_NONE) {
+    LOG_ERROR("[VideoPlayer] player_prepare_async failed: %s",
+              get_error_message(ret));
+    OnChannelChangeFailed(ret);
+    return false;
+  }
+  return true;
+}
+
+void VideoPlayer::OnChannelChangeFailed(int error_code) {
+  // The previous content has been unprepared, so the player stays idle
+  // until another channel is set. Let the controller know that it no longer
+  // has a playable video.
+  is_changing_channel_ = false;
+  is_initialized_ = false;
+  if (event_sink_) {
+    event_sink_->Error("Channel change failed", get_error_message(error_code));
   }
 }
 
@@ -256,6 +421,9 @@ VideoPlayer::~VideoPlayer() {
   if (drm_manager_) {
     drm_manager_->ReleaseDrmSession();
   }
+  if (prefetched_drm_manager_) {
+    prefetched_drm_manager_->ReleaseDrmSession();
+  }
   Dispose();
 }
 
@@ -338,6 +506,7 @@ void VideoPlayer::Dispose() {
   is_initialized_ = false;
   event_sink_ = nullptr;
   event_channel_->SetStreamHandler(nullptr);
+  CancelDisplayRoiUpdates();
 
   if (player_) {
     player_unprepare(player_);
@@ -436,6 +605,13 @@ void VideoPlayer::SendInitialized() {
     }
 
     is_initialized_ = true;
+    if (is_changing_channel_) {
+      is_changing_channel_ = false;
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - channel_change_start_);
+      LOG_INFO("[VideoPlayer] channel changed in %lld ms",
+               static_cast<long long>(elapsed.count()));
+    }
     flutter::EncodableMap encodables = {
         {flutter::EncodableValue("event"),
          flutter::EncodableValue("initialized")},
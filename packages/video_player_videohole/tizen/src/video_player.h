@@ -5,12 +5,14 @@
 #ifndef VIDEO_PLAYER_VIDEOHOLE_PLUGIN_VIDEO_PLAYER_H_
 #define VIDEO_PLAYER_VIDEOHOLE_PLUGIN_VIDEO_PLAYER_H_
 
+#include <Ecore.h>
 #include <flutter/encodable_value.h>
 #include <flutter/event_channel.h>
 #include <flutter/plugin_registrar.h>
 #include <flutter_tizen.h>
 #include <player.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -36,11 +38,25 @@ class VideoPlayer {
   int GetPosition();
   void Play();
   void Pause();
+  // Updates are coalesced and applied on the next display refresh.
   void SetDisplayRoi(int x, int y, int w, int h);
+  // Interpolates the display ROI from |begin| to |end| on every display
+  // refresh for |duration_ms|.
+  void AnimateDisplayRoi(int begin_x, int begin_y, int begin_w, int begin_h,
+                         int end_x, int end_y, int end_w, int end_h,
+                         int duration_ms);
   void SetLooping(bool is_looping);
   void SetPlaybackSpeed(double speed);
   void SeekTo(int position);
   void SetVolume(double volume);
+  // Switches to another content without recreating the player. The display
+  // is kept, and so is the DRM session if |drm_type| is the current one.
+  bool ChangeChannel(const std::string &uri, int drm_type,
+                     const std::string &license_url);
+  // Hands over a DRM session whose license was prefetched for the content
+  // of the next Create() or ChangeChannel(). The session is used if its DRM
+  // type matches the content and released otherwise.
+  void SetPrefetchedDrmSession(std::unique_ptr<DrmManager> drm_manager);
 
  private:
   void Initialize();
@@ -52,7 +68,24 @@ class VideoPlayer {
   void SendSubtitleUpdate(int duration, char *text);
   bool Open(const std::string &uri);
   void ParseCreateMessage(const CreateMessage &create_message);
+  void OnChannelChangeFailed(int error_code);
+  std::unique_ptr<DrmManager> TakePrefetchedDrmSession(int drm_type,
+                                                       const std::string &uri);
   bool SetDisplay(FlutterDesktopPluginRegistrarRef registrar_ref);
+  struct DisplayRoi {
+    int x;
+    int y;
+    int w;
+    int h;
+
+    bool operator==(const DisplayRoi &other) const {
+      return x == other.x && y == other.y && w == other.w && h == other.h;
+    }
+  };
+  void ApplyDisplayRoi(const DisplayRoi &roi);
+  void CancelDisplayRoiUpdates();
+  static Eina_Bool OnDisplayRoiFrame(void *data);
+  static Eina_Bool OnDisplayRoiAnimationFrame(void *data, double pos);
   static void OnPrepared(void *data);
   static void OnBuffering(int percent, void *data);
   static void OnSeekCompleted(void *data);
@@ -68,6 +101,7 @@ class VideoPlayer {
   player_h player_;
   FlutterDesktopPluginRegistrarRef registrar_ref_ = nullptr;
   std::unique_ptr<DrmManager> drm_manager_;
+  std::unique_ptr<DrmManager> prefetched_drm_manager_;
   std::string uri_;
   std::string license_url_;
   int64_t player_id_ = -1;
@@ -75,10 +109,18 @@ class VideoPlayer {
   bool is_initialized_ = false;
   bool is_interrupted_ = false;
   bool is_buffering_ = false;
+  bool is_changing_channel_ = false;
+  std::chrono::steady_clock::time_point channel_change_start_;
   int x_;
   int y_;
   int width_;
   int height_;
+  Ecore_Animator *roi_animator_ = nullptr;
+  Ecore_Animator *roi_timeline_ = nullptr;
+  DisplayRoi pending_roi_ = {};
+  DisplayRoi applied_roi_ = {};
+  DisplayRoi roi_begin_ = {};
+  DisplayRoi roi_end_ = {};
 };
 
 #endif  // VIDEO_PLAYER_VIDEOHOLE_PLUGIN_VIDEO_PLAYER_H_
@@ -5,21 +5,54 @@
 #include "video_player_tizen_plugin.h"
 
 #include <app_common.h>
+#include <flutter/binary_messenger.h>
 #include <flutter/event_channel.h>
 #include <flutter/event_stream_handler_functions.h>
 #include <flutter/plugin_registrar.h>
 #include <flutter/standard_method_codec.h>
 #include <flutter_tizen.h>
 
+#include <algorithm>
 #include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <mutex>
 
 #include "dart_api_dl.c"
+#include "drm_license_client.h"
 #include "log.h"
 #include "messages.h"
 #include "video_player.h"
 #include "video_player_options.h"
 
+// The maximum number of DRM sessions kept alive for license prefetching.
+static constexpr size_t kMaxPrefetchSessions = 4;
+
+// Binary alternatives to the position and setDisplayRoi pigeon messages,
+// which are sent frequently (position polling and layout changes). Both
+// requests are raw int64 values in host byte order: the player ID for
+// position, and the player ID followed by x, y, w, h for the display ROI.
+// The position reply is the position in milliseconds as an int64, and the
+// display ROI reply is a single byte. An empty reply means that the caller
+// should retry with the pigeon channel to get the error details.
+static constexpr char kPositionChannelName[] =
+    "flutter.io/videoPlayerVideohole/position";
+static constexpr char kDisplayRoiChannelName[] =
+    "flutter.io/videoPlayerVideohole/displayRoi";
+
+static void ParseDrmConfigs(const flutter::EncodableMap &drm_configs,
+                            int *drm_type, std::string *license_url) {
+  auto iter = drm_configs.find(flutter::EncodableValue("drmType"));
+  if (iter != drm_configs.end() && std::holds_alternative<int>(iter->second)) {
+    *drm_type = std::get<int>(iter->second);
+  }
+  iter = drm_configs.find(flutter::EncodableValue("licenseServerUrl"));
+  if (iter != drm_configs.end() &&
+      std::holds_alternative<std::string>(iter->second)) {
+    *license_url = std::get<std::string>(iter->second);
+  }
+}
+
 class VideoPlayerTizenPlugin : public flutter::Plugin, public VideoPlayerApi {
  public:
   static void RegisterWithRegistrar(
@@ -48,13 +81,29 @@ class VideoPlayerTizenPlugin : public flutter::Plugin, public VideoPlayerApi {
       const MixWithOthersMessage &mixWithOthersMsg) override;
   std::optional<FlutterError> SetDisplayRoi(
       const GeometryMessage &geometryMsg) override;
+  std::optional<FlutterError> PrefetchLicense(
+      const PrefetchMessage &prefetchMsg) override;
+  std::optional<FlutterError> AnimateDisplayRoi(
+      const GeometryAnimationMessage &animationMsg) override;
+  std::optional<FlutterError> ChangeChannel(
+      const ChannelMessage &channelMsg) override;
 
  private:
   void DisposeAllPlayers();
+  std::unique_ptr<DrmManager> TakePrefetchSession(const std::string &uri);
+  void ReleasePrefetchSession(const std::string &uri);
+  void ReleaseAllPrefetchSessions();
+  void HandlePositionMessage(const uint8_t *message, size_t message_size,
+                             const flutter::BinaryReply &reply);
+  void HandleDisplayRoiMessage(const uint8_t *message, size_t message_size,
+                               const flutter::BinaryReply &reply);
   FlutterDesktopPluginRegistrarRef registrar_ref_;
   VideoPlayerOptions options_;
   flutter::PluginRegistrar *plugin_registrar_;
   std::map<int64_t, std::unique_ptr<VideoPlayer>> players_;
+  std::map<std::string, std::unique_ptr<DrmManager>> prefetch_sessions_;
+  // The keys of |prefetch_sessions_|, oldest first.
+  std::deque<std::string> prefetch_order_;
 };
 
 void VideoPlayerTizenPlugin::RegisterWithRegistrar(
@@ -70,9 +119,29 @@ VideoPlayerTizenPlugin::VideoPlayerTizenPlugin(
     flutter::PluginRegistrar *plugin_registrar)
     : registrar_ref_(registrar_ref), plugin_registrar_(plugin_registrar) {
   VideoPlayerApi::SetUp(plugin_registrar_->messenger(), this);
+  plugin_registrar_->messenger()->SetMessageHandler(
+      kPositionChannelName,
+      [this](const uint8_t *message, size_t message_size,
+             flutter::BinaryReply reply) {
+        HandlePositionMessage(message, message_size, reply);
+      });
+  plugin_registrar_->messenger()->SetMessageHandler(
+      kDisplayRoiChannelName,
+      [this](const uint8_t *message, size_t message_size,
+             flutter::BinaryReply reply) {
+        HandleDisplayRoiMessage(message, message_size, reply);
+      });
 }
 
-VideoPlayerTizenPlugin::~VideoPlayerTizenPlugin() { DisposeAllPlayers(); }
+VideoPlayerTizenPlugin::~VideoPlayerTizenPlugin() {
+  plugin_registrar_->messenger()->SetMessageHandler(kPositionChannelName,
+                                                    nullptr);
+  plugin_registrar_->messenger()->SetMessageHandler(kDisplayRoiChannelName,
+                                                    nullptr);
+  DisposeAllPlayers();
+  ReleaseAllPrefetchSessions();
+  DrmLicenseClient::GetInstance().Shutdown();
+}
 
 void VideoPlayerTizenPlugin::DisposeAllPlayers() {
   auto iter = players_.begin();
@@ -83,8 +152,40 @@ void VideoPlayerTizenPlugin::DisposeAllPlayers() {
   players_.clear();
 }
 
+std::unique_ptr<DrmManager> VideoPlayerTizenPlugin::TakePrefetchSession(
+    const std::string &uri) {
+  auto iter = prefetch_sessions_.find(uri);
+  if (iter == prefetch_sessions_.end()) {
+    return nullptr;
+  }
+  std::unique_ptr<DrmManager> drm_manager = std::move(iter->second);
+  prefetch_sessions_.erase(iter);
+  prefetch_order_.erase(
+      std::find(prefetch_order_.begin(), prefetch_order_.end(), uri));
+  return drm_manager;
+}
+
+void VideoPlayerTizenPlugin::ReleasePrefetchSession(const std::string &uri) {
+  auto iter = prefetch_sessions_.find(uri);
+  if (iter != prefetch_sessions_.end()) {
+    iter->second->ReleaseDrmSession();
+    prefetch_sessions_.erase(iter);
+    prefetch_order_.erase(
+        std::find(prefetch_order_.begin(), prefetch_order_.end(), uri));
+  }
+}
+
+void VideoPlayerTizenPlugin::ReleaseAllPrefetchSessions() {
+  for (auto &entry : prefetch_sessions_) {
+    entry.second->ReleaseDrmSession();
+  }
+  prefetch_sessions_.clear();
+  prefetch_order_.clear();
+}
+
 std::optional<FlutterError> VideoPlayerTizenPlugin::Initialize() {
   DisposeAllPlayers();
+  ReleaseAllPrefetchSessions();
   return {};
 }
 
@@ -92,6 +193,11 @@ ErrorOr<std::unique_ptr<PlayerMessage>> VideoPlayerTizenPlugin::Create(
     const CreateMessage &createMsg) {
   std::unique_ptr<VideoPlayer> player =
       std::make_unique<VideoPlayer>(registrar_ref_, createMsg);
+  if (createMsg.uri()) {
+    // The license may have been prefetched (or still be being acquired) by a
+    // session for this content, which the player takes over.
+    player->SetPrefetchedDrmSession(TakePrefetchSession(*createMsg.uri()));
+  }
   DrmManager::GetChallengeData(ChallengeCb);
   std::unique_ptr<PlayerMessage> player_message =
       std::make_unique<PlayerMessage>();
@@ -160,15 +266,35 @@ std::optional<FlutterError> VideoPlayerTizenPlugin::Pause(
 
 ErrorOr<std::unique_ptr<PositionMessage>> VideoPlayerTizenPlugin::Position(
     const PlayerMessage &playerMsg) {
-  std::unique_ptr<PositionMessage> result = std::make_unique<PositionMessage>();
   auto iter = players_.find(playerMsg.player_id());
-  if (iter != players_.end()) {
-    result->set_player_id(playerMsg.player_id());
-    result->set_position(iter->second->GetPosition());
+  if (iter == players_.end()) {
+    return FlutterError("Invalid argument", "Player not found.");
   }
+  std::unique_ptr<PositionMessage> result = std::make_unique<PositionMessage>();
+  result->set_player_id(playerMsg.player_id());
+  result->set_position(iter->second->GetPosition());
   return ErrorOr<PositionMessage>::MakeWithUniquePtr(std::move(result));
 }
 
+void VideoPlayerTizenPlugin::HandlePositionMessage(
+    const uint8_t *message, size_t message_size,
+    const flutter::BinaryReply &reply) {
+  int64_t player_id = 0;
+  if (message_size != sizeof(player_id)) {
+    reply(nullptr, 0);
+    return;
+  }
+  std::memcpy(&player_id, message, sizeof(player_id));
+
+  auto iter = players_.find(player_id);
+  if (iter == players_.end()) {
+    reply(nullptr, 0);
+    return;
+  }
+  int64_t position = iter->second->GetPosition();
+  reply(reinterpret_cast<const uint8_t *>(&position), sizeof(position));
+}
+
 std::optional<FlutterError> VideoPlayerTizenPlugin::SeekTo(
     const PositionMessage &positionMsg) {
   auto iter = players_.find(positionMsg.player_id());
@@ -181,10 +307,89 @@ std::optional<FlutterError> VideoPlayerTizenPlugin::SeekTo(
 std::optional<FlutterError> VideoPlayerTizenPlugin::SetDisplayRoi(
     const GeometryMessage &geometryMsg) {
   auto iter = players_.find(geometryMsg.player_id());
+  if (iter == players_.end()) {
+    return FlutterError("Invalid argument", "Player not found.");
+  }
+  iter->second->SetDisplayRoi(geometryMsg.x(), geometryMsg.y(),
+                              geometryMsg.w(), geometryMsg.h());
+  return {};
+}
+
+void VideoPlayerTizenPlugin::HandleDisplayRoiMessage(
+    const uint8_t *message, size_t message_size,
+    const flutter::BinaryReply &reply) {
+  int64_t values[5];
+  if (message_size != sizeof(values)) {
+    reply(nullptr, 0);
+    return;
+  }
+  std::memcpy(values, message, sizeof(values));
+  auto iter = players_.find(values[0]);
+  if (iter == players_.end()) {
+    reply(nullptr, 0);
+    return;
+  }
+  iter->second->SetDisplayRoi(values[1], values[2], values[3], values[4]);
+  const uint8_t ack = 1;
+  reply(&ack, sizeof(ack));
+}
+
+std::optional<FlutterError> VideoPlayerTizenPlugin::AnimateDisplayRoi(
+    const GeometryAnimationMessage &animationMsg) {
+  auto iter = players_.find(animationMsg.player_id());
   if (iter != players_.end()) {
-    iter->second->SetDisplayRoi(geometryMsg.x(), geometryMsg.y(),
-                                geometryMsg.w(), geometryMsg.h());
+    iter->second->AnimateDisplayRoi(
+        animationMsg.begin_x(), animationMsg.begin_y(), animationMsg.begin_w(),
+        animationMsg.begin_h(), animationMsg.end_x(), animationMsg.end_y(),
+        animationMsg.end_w(), animationMsg.end_h(), animationMsg.duration());
+  }
+  return {};
+}
+
+std::optional<FlutterError> VideoPlayerTizenPlugin::ChangeChannel(
+    const ChannelMessage &channelMsg) {
+  auto iter = players_.find(channelMsg.player_id());
+  if (iter == players_.end()) {
+    return FlutterError("Invalid argument", "Player not found.");
+  }
+  int drm_type = DRM_TYPE_NONE;
+  std::string license_url;
+  ParseDrmConfigs(channelMsg.drm_configs(), &drm_type, &license_url);
+  // The license of the new channel may have been prefetched.
+  iter->second->SetPrefetchedDrmSession(TakePrefetchSession(channelMsg.uri()));
+  if (!iter->second->ChangeChannel(channelMsg.uri(), drm_type, license_url)) {
+    return FlutterError("Channel change failed",
+                        "Failed to prepare the new channel.");
+  }
+  return {};
+}
+
+std::optional<FlutterError> VideoPlayerTizenPlugin::PrefetchLicense(
+    const PrefetchMessage &prefetchMsg) {
+  int drm_type = DRM_TYPE_NONE;
+  std::string license_url;
+  ParseDrmConfigs(prefetchMsg.drm_configs(), &drm_type, &license_url);
+  if (drm_type == DRM_TYPE_NONE || license_url.empty()) {
+    return FlutterError("Invalid argument",
+                        "drmType and licenseServerUrl must be specified.");
+  }
+
+  const std::string &uri = prefetchMsg.uri();
+  ReleasePrefetchSession(uri);
+  if (prefetch_sessions_.size() >= kMaxPrefetchSessions) {
+    // Evict the oldest prefetch.
+    ReleasePrefetchSession(std::string(prefetch_order_.front()));
+  }
+
+  auto drm_manager =
+      std::make_unique<DrmManager>(drm_type, license_url, nullptr);
+  if (!drm_manager->PrefetchLicense(uri, prefetchMsg.pssh())) {
+    drm_manager->ReleaseDrmSession();
+    return FlutterError("Prefetch failed",
+                        "Failed to start acquiring the license.");
   }
+  prefetch_sessions_[uri] = std::move(drm_manager);
+  prefetch_order_.push_back(uri);
   return {};
 }
 
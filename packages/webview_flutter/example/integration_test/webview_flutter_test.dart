@@ -19,9 +19,11 @@ import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:integration_test/integration_test.dart';
 import 'package:webview_flutter/webview_flutter.dart';
+import 'package:webview_flutter_tizen/webview_flutter_tizen.dart';
 
 Future<void> main() async {
-  IntegrationTestWidgetsFlutterBinding.ensureInitialized();
+  final IntegrationTestWidgetsFlutterBinding binding =
+      IntegrationTestWidgetsFlutterBinding.ensureInitialized();
 
   final HttpServer server = await HttpServer.bind(InternetAddress.anyIPv4, 0);
   server.forEach((HttpRequest request) {
@@ -133,6 +135,69 @@ Future<void> main() async {
     await expectLater(channelCompleter.future, completion('hello'));
   });
 
+  testWidgets('batched JavascriptChannel', (WidgetTester tester) async {
+    final Completer<void> pageFinished = Completer<void>();
+    final WebViewController controller = WebViewController()
+      ..setJavaScriptMode(JavaScriptMode.unrestricted)
+      ..setNavigationDelegate(
+        NavigationDelegate(onPageFinished: (_) => pageFinished.complete()),
+      );
+    final TizenWebViewController tizenController =
+        controller.platform as TizenWebViewController;
+
+    final List<String> messages = <String>[];
+    final Completer<void> allReceived = Completer<void>();
+    await tizenController.addJavaScriptChannel(TizenJavaScriptChannelParams(
+      name: 'Echo',
+      onMessageReceived: (JavaScriptMessage message) {
+        messages.add(message.message);
+        if (messages.length == 3) {
+          allReceived.complete();
+        }
+      },
+      batched: true,
+    ));
+
+    await controller.loadHtmlString(
+      'data:text/html;charset=utf-8;base64,PCFET0NUWVBFIGh0bWw+',
+    );
+
+    await tester.pumpWidget(WebViewWidget(controller: controller));
+
+    await pageFinished.future;
+
+    await tizenController.runJavaScriptBatch(<String>[
+      'Echo.postMessage("one");',
+      'Echo.postMessage("two, \\"quoted\\"");',
+      'Echo.postMessage("three");',
+    ]);
+    await allReceived.future;
+    expect(messages, <String>['one', 'two, "quoted"', 'three']);
+  });
+
+  testWidgets('reports time to first frame', (WidgetTester tester) async {
+    final Completer<void> pageFinished = Completer<void>();
+    final WebViewController controller = WebViewController()
+      ..setNavigationDelegate(
+        NavigationDelegate(onPageFinished: (_) => pageFinished.complete()),
+      )
+      ..loadRequest(Uri.parse(primaryUrl));
+    final TizenWebViewController tizenController =
+        controller.platform as TizenWebViewController;
+
+    await tester.pumpWidget(WebViewWidget(controller: controller));
+    await pageFinished.future;
+    await tester.pumpAndSettle(const Duration(milliseconds: 500));
+
+    final Map<String, int> counters = await tizenController.getFrameCounters();
+    expect(counters['firstFrameMs'], greaterThanOrEqualTo(0));
+    binding.reportData = <String, dynamic>{
+      ...?binding.reportData,
+      'firstFrameMs': counters['firstFrameMs'],
+      'prewarmed': counters['prewarmed'],
+    };
+  });
+
   testWidgets('resize webview', (WidgetTester tester) async {
     final Completer<void> initialResizeCompleter = Completer<void>();
     final Completer<void> buttonTapResizeCompleter = Completer<void>();
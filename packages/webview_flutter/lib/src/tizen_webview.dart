@@ -4,7 +4,11 @@
 // found in the LICENSE file.
 
 import 'dart:async';
+import 'dart:convert';
+// ignore: unnecessary_import
+import 'dart:typed_data';
 
+import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
 import 'package:flutter_tizen/widgets.dart';
 import 'package:webview_flutter_platform_interface/webview_flutter_platform_interface.dart';
@@ -16,6 +20,24 @@ const String kTizenWebViewChannelName = 'plugins.flutter.io/tizen_webview_';
 typedef NavigationDelegateMethodChannelCallback = Future<dynamic> Function(
     MethodCall method);
 
+/// Tizen specific parameters of a JavaScript channel.
+@immutable
+class TizenJavaScriptChannelParams extends JavaScriptChannelParams {
+  /// Creates a new [TizenJavaScriptChannelParams] object.
+  TizenJavaScriptChannelParams({
+    required super.name,
+    required super.onMessageReceived,
+    this.batched = false,
+  });
+
+  /// Whether messages posted by the page are queued and delivered together
+  /// after the script that posted them has finished.
+  ///
+  /// Use this for channels which receive many small messages. The messages are
+  /// still delivered to [onMessageReceived] one by one and in order.
+  final bool batched;
+}
+
 /// A Tizen webview that displays web pages.
 class TizenWebView {
   /// Whether the [TizenNavigationDelegate] is set by the [PlatformWebViewController].
@@ -40,6 +62,21 @@ class TizenWebView {
               ?.onMessageReceived(JavaScriptMessage(message: message));
         }
 
+        return true;
+      case 'javaScriptChannelMessages':
+        final List<Object?> arguments = call.arguments as List<Object?>;
+        final String channel = arguments[0]! as String;
+        final JavaScriptChannelParams? params =
+            _javaScriptChannelParams[channel];
+        if (params != null) {
+          final List<dynamic> messages =
+              jsonDecode(arguments[1]! as String) as List<dynamic>;
+          for (final dynamic message in messages) {
+            params.onMessageReceived(
+                JavaScriptMessage(message: message as String));
+          }
+        }
+
         return true;
     }
 
@@ -172,6 +209,14 @@ class TizenWebView {
       JavaScriptChannelParams javaScriptChannelParams) {
     _javaScriptChannelParams[javaScriptChannelParams.name] =
         javaScriptChannelParams;
+    if (javaScriptChannelParams is TizenJavaScriptChannelParams &&
+        javaScriptChannelParams.batched) {
+      return _invokeChannelMethod<void>(
+          'addJavaScriptChannel', <String, dynamic>{
+        'name': javaScriptChannelParams.name,
+        'batched': true,
+      });
+    }
     return _invokeChannelMethod<void>(
         'addJavaScriptChannel', javaScriptChannelParams.name);
   }
@@ -180,6 +225,16 @@ class TizenWebView {
   Future<void> runJavaScript(String javaScript) =>
       _invokeChannelMethod<void>('runJavaScript', javaScript);
 
+  /// Runs the given scripts in order in the context of the current page.
+  ///
+  /// The returned future completes once after the last script has run.
+  Future<void> runJavaScriptBatch(List<String> javaScripts) {
+    if (javaScripts.isEmpty) {
+      return Future<void>.value();
+    }
+    return _invokeChannelMethod<void>('runJavaScriptBatch', javaScripts);
+  }
+
   /// Runs the given JavaScript in the context of the current page, and returns the result.
   Future<Object> runJavaScriptReturningResult(String javaScript) async {
     final String? result = await _invokeChannelMethod<String?>(
@@ -194,6 +249,38 @@ class TizenWebView {
     return num.tryParse(result) ?? result;
   }
 
+  /// Limits how often new frames are presented. 0 removes the limit.
+  Future<void> setMaxFrameRate(int frameRate) =>
+      _invokeChannelMethod<void>('setMaxFrameRate', frameRate);
+
+  /// Sets whether the webview is visible to the user.
+  Future<void> setVisible(bool visible) =>
+      _invokeChannelMethod<void>('setVisible', visible);
+
+  /// Suspends or resumes the web engine of this webview.
+  Future<void> setSuspended(bool suspended) =>
+      _invokeChannelMethod<void>('setSuspended', suspended);
+
+  /// Captures the frame currently displayed as a JPEG image.
+  Future<Uint8List?> takeSnapshot({
+    int? maxWidth,
+    int? maxHeight,
+    int quality = 90,
+  }) {
+    return _invokeChannelMethod<Uint8List>('takeSnapshot', <String, dynamic>{
+      'maxWidth': maxWidth,
+      'maxHeight': maxHeight,
+      'quality': quality,
+    });
+  }
+
+  /// Returns the frame counters of this webview.
+  Future<Map<String, int>> getFrameCounters() async {
+    final Map<Object?, Object?>? counters =
+        await _invokeChannelMethod<Map<Object?, Object?>>('getFrameCounters');
+    return counters?.cast<String, int>() ?? <String, int>{};
+  }
+
   /// Sets the value used for the HTTP `User-Agent:` request header.
   Future<void> setUserAgent(String? userAgent) =>
       _invokeChannelMethod<void>('userAgent', userAgent);
@@ -4,6 +4,8 @@
 // found in the LICENSE file.
 
 import 'dart:async';
+// ignore: unnecessary_import
+import 'dart:typed_data';
 
 import 'package:flutter/material.dart';
 import 'package:flutter/services.dart';
@@ -25,6 +27,7 @@ class TizenWebViewController extends PlatformWebViewController {
 
   final TizenWebView _webview;
   late TizenNavigationDelegate _tizenNavigationDelegate;
+  _SuspendOnBackgroundObserver? _lifecycleObserver;
 
   /// Called when [TizenView] is created.
   void onCreate(int viewId) {
@@ -144,6 +147,88 @@ class TizenWebViewController extends PlatformWebViewController {
   Future<void> runJavaScript(String javaScript) =>
       _webview.runJavaScript(javaScript);
 
+  /// Limits how often new frames of the webview are presented to
+  /// [frameRate] frames per second.
+  ///
+  /// Content that animates faster than needed then costs less GPU and CPU
+  /// time. Pass 0 (the default) to present every rendered frame.
+  Future<void> setMaxFrameRate(int frameRate) {
+    assert(frameRate >= 0);
+    return _webview.setMaxFrameRate(frameRate);
+  }
+
+  /// Sets whether the webview is visible to the user.
+  ///
+  /// Call this with false when the webview is covered, e.g. by another route.
+  /// The web engine then stops rendering and no frames are presented until
+  /// this is called with true again.
+  Future<void> setVisible(bool visible) => _webview.setVisible(visible);
+
+  /// Sets whether the web engine is suspended while the app is in the
+  /// background.
+  ///
+  /// A suspended engine stops JavaScript timers and rendering. Defaults to
+  /// false.
+  Future<void> setSuspendWhenBackgrounded(bool suspend) async {
+    if (suspend) {
+      if (_lifecycleObserver == null) {
+        _lifecycleObserver = _SuspendOnBackgroundObserver(_webview);
+        WidgetsBinding.instance.addObserver(_lifecycleObserver!);
+      }
+    } else if (_lifecycleObserver != null) {
+      WidgetsBinding.instance.removeObserver(_lifecycleObserver!);
+      _lifecycleObserver = null;
+      await _webview.setSuspended(false);
+    }
+  }
+
+  /// Captures the frame the webview currently displays as a JPEG image.
+  ///
+  /// The image is downscaled by an integer factor to fit within [maxWidth]
+  /// and [maxHeight] if given, and encoded with [quality] (1 to 100) off the
+  /// platform thread. This is meant for page thumbnails and route
+  /// transitions.
+  ///
+  /// The frame is copied from the surface the web engine rendered it into.
+  /// Until the copy is done, the surface is held like a displayed frame and
+  /// no new frame is taken into it. The engine owns the surface, though, so
+  /// if it draws into a frame that is still displayed, the snapshot can show
+  /// the same tearing as the display.
+  ///
+  /// Returns null if the webview has not been created yet.
+  Future<Uint8List?> takeSnapshot({
+    int? maxWidth,
+    int? maxHeight,
+    int quality = 90,
+  }) {
+    return _webview.takeSnapshot(
+        maxWidth: maxWidth, maxHeight: maxHeight, quality: quality);
+  }
+
+  /// Returns the frame counters of the webview.
+  ///
+  /// The map contains the number of frames `rendered` by the engine and
+  /// `presented` to Flutter. Every other rendered frame, except the latest
+  /// one if it is still pending, was replaced by a newer frame and is counted
+  /// once: as `delayed` if it was held back by [setMaxFrameRate], as `hidden`
+  /// if the view was hidden, and as `skipped` otherwise.
+  /// `poolExhausted` is the number of frames for which all buffers were still
+  /// displayed, which is a sign that
+  /// [TizenWebViewWidgetCreationParams.bufferPoolSize] is too small.
+  ///
+  /// It also contains `firstFrameMs`, the time in milliseconds from the
+  /// creation of the view to its first rendered frame (-1 if no frame has
+  /// been rendered yet), and `prewarmed`, which is 1 if the view took an
+  /// instance created in advance by `TizenWebViewPlatform.setWarmUpPoolSize`.
+  Future<Map<String, int>> getFrameCounters() => _webview.getFrameCounters();
+
+  /// Runs the given scripts in order in the context of the current page.
+  ///
+  /// This is cheaper than calling [runJavaScript] for each script. The
+  /// returned future completes once after the last script has run.
+  Future<void> runJavaScriptBatch(List<String> javaScripts) =>
+      _webview.runJavaScriptBatch(javaScripts);
+
   @override
   Future<Object> runJavaScriptReturningResult(String javaScript) =>
       _webview.runJavaScriptReturningResult(javaScript);
@@ -153,6 +238,59 @@ class TizenWebViewController extends PlatformWebViewController {
       _webview.setUserAgent(userAgent);
 }
 
+class _SuspendOnBackgroundObserver with WidgetsBindingObserver {
+  _SuspendOnBackgroundObserver(this._webview);
+
+  final TizenWebView _webview;
+
+  @override
+  void didChangeAppLifecycleState(AppLifecycleState state) {
+    if (state == AppLifecycleState.paused) {
+      _webview.setSuspended(true);
+    } else if (state == AppLifecycleState.resumed) {
+      _webview.setSuspended(false);
+    }
+  }
+}
+
+/// Object specifying creation parameters for creating a [TizenWebViewWidget].
+///
+/// When adding additional fields make sure they can be null or have a default
+/// value to avoid breaking changes. See [PlatformWebViewWidgetCreationParams]
+/// for more information.
+@immutable
+class TizenWebViewWidgetCreationParams
+    extends PlatformWebViewWidgetCreationParams {
+  /// Creates [TizenWebViewWidgetCreationParams].
+  const TizenWebViewWidgetCreationParams({
+    super.key,
+    required super.controller,
+    super.layoutDirection,
+    super.gestureRecognizers,
+    this.bufferPoolSize,
+  });
+
+  /// Creates a [TizenWebViewWidgetCreationParams] instance based on
+  /// [PlatformWebViewWidgetCreationParams].
+  TizenWebViewWidgetCreationParams.fromPlatformWebViewWidgetCreationParams(
+    PlatformWebViewWidgetCreationParams params, {
+    int? bufferPoolSize,
+  }) : this(
+          key: params.key,
+          controller: params.controller,
+          layoutDirection: params.layoutDirection,
+          gestureRecognizers: params.gestureRecognizers,
+          bufferPoolSize: bufferPoolSize,
+        );
+
+  /// The number of buffers used to pass rendered frames to Flutter.
+  ///
+  /// More buffers let the web engine keep rendering while earlier frames are
+  /// still being composited, at the cost of memory. Values are clamped to the
+  /// range 2 to 10. Defaults to 5 when null.
+  final int? bufferPoolSize;
+}
+
 /// An implementation of [PlatformWebViewWidget] with the Tizen WebView API.
 class TizenWebViewWidget extends PlatformWebViewWidget {
   /// Constructs a [TizenWebViewWidget].
@@ -170,6 +308,12 @@ class TizenWebViewWidget extends PlatformWebViewWidget {
       },
       layoutDirection: params.layoutDirection,
       gestureRecognizers: params.gestureRecognizers,
+      creationParams: <String, dynamic>{
+        if (params is TizenWebViewWidgetCreationParams)
+          'bufferPoolSize':
+              (params as TizenWebViewWidgetCreationParams).bufferPoolSize,
+      },
+      creationParamsCodec: const StandardMessageCodec(),
     );
   }
 }
@@ -3,6 +3,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'package:flutter/services.dart';
 import 'package:webview_flutter_platform_interface/webview_flutter_platform_interface.dart';
 
 import 'tizen_webview_controller.dart';
@@ -10,6 +11,44 @@ import 'tizen_webview_cookie_manager.dart';
 
 /// An implementation of [WebViewPlatform] using the Tizen WebView API.
 class TizenWebViewPlatform extends WebViewPlatform {
+  static const MethodChannel _factoryChannel =
+      MethodChannel('plugins.flutter.io/tizen_webview_factory');
+
+  /// Sets the number of blank webview instances to be created in advance.
+  ///
+  /// The instances are created while the app is idle and handed out to new
+  /// webviews, which shortens the time to open a page. The pool is refilled
+  /// after an instance is used. At most 3 instances are kept, and setting the
+  /// size to 0 (the default) releases all of them.
+  static Future<void> setWarmUpPoolSize(int size) {
+    assert(size >= 0);
+    return _factoryChannel.invokeMethod<void>('setWarmUpPoolSize', size);
+  }
+
+  /// Configures the cache shared by all webviews in the app.
+  ///
+  /// [cacheModel] chooses how much memory and disk the engine may spend on
+  /// caching resources. [prefetchUrls] are loaded one by one in a hidden
+  /// webview so that their resources are already cached when a webview
+  /// opens them later.
+  ///
+  /// The cache model is applied once per process, when the first webview is
+  /// created or this is first called, whichever comes first, so this should
+  /// be called before the first webview is created. The cache model of later
+  /// calls is ignored, but their [prefetchUrls] are still loaded.
+  static Future<void> setCacheConfiguration({
+    TizenCacheModel cacheModel = TizenCacheModel.primaryWebBrowser,
+    List<String> prefetchUrls = const <String>[],
+  }) {
+    return _factoryChannel.invokeMethod<void>(
+      'setCacheConfiguration',
+      <String, Object>{
+        'cacheModel': cacheModel.name,
+        'prefetchUrls': prefetchUrls,
+      },
+    );
+  }
+
   @override
   PlatformWebViewController createPlatformWebViewController(
     PlatformWebViewControllerCreationParams params,
@@ -43,3 +82,15 @@ class TizenWebViewPlatform extends WebViewPlatform {
     WebViewPlatform.instance = TizenWebViewPlatform();
   }
 }
+
+/// The cache models of the web engine, from the smallest to the largest.
+enum TizenCacheModel {
+  /// Disables most caching, for apps which show a single local document.
+  documentViewer,
+
+  /// Caches moderately, for apps which show a few remote documents.
+  documentBrowser,
+
+  /// Caches aggressively, like a general purpose web browser.
+  primaryWebBrowser,
+}
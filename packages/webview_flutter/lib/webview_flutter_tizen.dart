@@ -5,6 +5,7 @@
 
 library webview_flutter_tizen;
 
+export 'src/tizen_webview.dart' show TizenJavaScriptChannelParams;
 export 'src/tizen_webview_controller.dart';
 export 'src/tizen_webview_cookie_manager.dart';
 export 'src/tizen_webview_platform.dart';
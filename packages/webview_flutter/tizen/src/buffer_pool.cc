@@ -4,12 +4,35 @@
 
 #include "buffer_pool.h"
 
+#include <tbm_surface_internal.h>
+
 #include "log.h"
 
-BufferUnit::BufferUnit(int32_t width, int32_t height) { Reset(width, height); }
+namespace {
+
+// Surfaces are allocated in steps of this size so that small size changes,
+// e.g. during an animated layout change, do not reallocate them.
+constexpr int32_t kSizeClassStep = 128;
+
+int32_t RoundUpToSizeClass(int32_t size) {
+  return (size + kSizeClassStep - 1) / kSizeClassStep * kSizeClassStep;
+}
+
+}  // namespace
+
+BufferUnit::BufferUnit(int32_t width, int32_t height, bool use_external_buffer)
+    : use_external_buffer_(use_external_buffer) {
+  gpu_surface_ = new FlutterDesktopGpuSurfaceDescriptor();
+  gpu_surface_->release_callback = &BufferUnit::OnReleased;
+  gpu_surface_->release_context = this;
+  Reset(width, height);
+}
 
 BufferUnit::~BufferUnit() {
-  if (tbm_surface_ && !use_external_buffer_) {
+  if (use_external_buffer_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReleaseExternalBuffer();
+  } else if (tbm_surface_) {
     tbm_surface_destroy(tbm_surface_);
     tbm_surface_ = nullptr;
   }
@@ -19,88 +42,160 @@ BufferUnit::~BufferUnit() {
   }
 }
 
-void BufferUnit::UseExternalBuffer() {
+void BufferUnit::SetExternalBuffer(tbm_surface_h tbm_surface) {
   if (!use_external_buffer_) {
-    use_external_buffer_ = true;
-    if (tbm_surface_) {
-      tbm_surface_destroy(tbm_surface_);
-      tbm_surface_ = nullptr;
-    }
+    return;
   }
+  std::lock_guard<std::mutex> lock(mutex_);
+  ReleaseExternalBuffer();
+  tbm_surface_internal_ref(tbm_surface);
+  tbm_surface_ = tbm_surface;
+  gpu_surface_->handle = tbm_surface_;
+  gpu_surface_->width = tbm_surface_get_width(tbm_surface_);
+  gpu_surface_->height = tbm_surface_get_height(tbm_surface_);
+  gpu_surface_->visible_width = gpu_surface_->width;
+  gpu_surface_->visible_height = gpu_surface_->height;
 }
 
-void BufferUnit::SetExternalBuffer(tbm_surface_h tbm_surface) {
-  if (use_external_buffer_) {
-    tbm_surface_ = tbm_surface;
-    gpu_surface_->handle = tbm_surface_;
+void BufferUnit::ReleaseExternalBuffer() {
+  if (use_external_buffer_ && tbm_surface_) {
+    tbm_surface_internal_unref(tbm_surface_);
+    tbm_surface_ = nullptr;
+    gpu_surface_->handle = nullptr;
   }
 }
 
 bool BufferUnit::MarkInUse() {
-  if (!is_used_) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_used_ && hold_count_ == 0) {
     is_used_ = true;
     return true;
   }
   return false;
 }
 
-void BufferUnit::UnmarkInUse() { is_used_ = false; }
+void BufferUnit::UnmarkInUse() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  is_used_ = false;
+  if (hold_count_ == 0) {
+    ReleaseExternalBuffer();
+  }
+}
+
+bool BufferUnit::IsUsed() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return is_used_ && tbm_surface_;
+}
+
+void BufferUnit::MarkHeldByEngine() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  hold_count_++;
+}
 
 tbm_surface_h BufferUnit::Surface() {
-  if (IsUsed()) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_used_) {
     return tbm_surface_;
   }
   return nullptr;
 }
 
-void BufferUnit::Reset(int32_t width, int32_t height) {
+bool BufferUnit::Reset(int32_t width, int32_t height) {
   if (width_ == width && height_ == height) {
-    return;
+    return false;
   }
   width_ = width;
   height_ = height;
 
+  if (use_external_buffer_) {
+    // The size of an external buffer is determined by its producer.
+    return false;
+  }
+
+  gpu_surface_->visible_width = width_;
+  gpu_surface_->visible_height = height_;
+
+  int32_t allocated_width = RoundUpToSizeClass(width_);
+  int32_t allocated_height = RoundUpToSizeClass(height_);
+  if (tbm_surface_ && allocated_width_ == allocated_width &&
+      allocated_height_ == allocated_height) {
+    return false;
+  }
+  allocated_width_ = allocated_width;
+  allocated_height_ = allocated_height;
+
   if (tbm_surface_) {
     tbm_surface_destroy(tbm_surface_);
     tbm_surface_ = nullptr;
   }
-  if (gpu_surface_) {
-    delete gpu_surface_;
-    gpu_surface_ = nullptr;
+  tbm_surface_ = tbm_surface_create(allocated_width_, allocated_height_,
+                                    TBM_FORMAT_ARGB8888);
+  if (!tbm_surface_) {
+    LOG_ERROR("Failed to create a tbm surface of %d x %d.", allocated_width_,
+              allocated_height_);
+    allocated_width_ = 0;
+    allocated_height_ = 0;
   }
-
-  tbm_surface_ = tbm_surface_create(width_, height_, TBM_FORMAT_ARGB8888);
-  gpu_surface_ = new FlutterDesktopGpuSurfaceDescriptor();
-  gpu_surface_->width = width_;
-  gpu_surface_->height = height_;
+  gpu_surface_->width = allocated_width_;
+  gpu_surface_->height = allocated_height_;
   gpu_surface_->handle = tbm_surface_;
-  gpu_surface_->release_callback = [](void* release_context) {
-    BufferUnit* buffer = reinterpret_cast<BufferUnit*>(release_context);
-    buffer->UnmarkInUse();
-  };
-  gpu_surface_->release_context = this;
+  return true;
+}
+
+void BufferUnit::ReleaseHold() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (hold_count_ == 0) {
+    LOG_ERROR("Released a buffer that is not held.");
+    return;
+  }
+  if (--hold_count_ == 0 && !is_used_) {
+    ReleaseExternalBuffer();
+  }
+}
+
+void BufferUnit::OnReleased(void* release_context) {
+  BufferUnit* buffer = reinterpret_cast<BufferUnit*>(release_context);
+  buffer->ReleaseHold();
 }
 
-BufferPool::BufferPool(int32_t width, int32_t height, size_t pool_size) {
+BufferPool::BufferPool(int32_t width, int32_t height, size_t pool_size,
+                       bool use_external_buffer)
+    : width_(width), height_(height) {
   for (size_t index = 0; index < pool_size; index++) {
-    pool_.emplace_back(std::make_unique<BufferUnit>(width, height));
+    pool_.emplace_back(
+        std::make_unique<BufferUnit>(width, height, use_external_buffer));
   }
-  Prepare(width, height);
 }
 
 BufferPool::~BufferPool() {}
 
 BufferUnit* BufferPool::GetAvailableBuffer() {
-  std::lock_guard<std::mutex> lock(mutex_);
-  for (size_t index = 0; index < pool_.size(); index++) {
-    size_t current = (index + last_index_) % pool_.size();
-    BufferUnit* buffer = pool_[current].get();
-    if (buffer->MarkInUse()) {
-      last_index_ = current;
-      return buffer;
+  int32_t width = 0;
+  int32_t height = 0;
+  BufferUnit* buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    width = width_;
+    height = height_;
+    for (size_t index = 0; index < pool_.size(); index++) {
+      size_t current = (index + last_index_) % pool_.size();
+      if (pool_[current]->MarkInUse()) {
+        buffer = pool_[current].get();
+        last_index_ = current;
+        break;
+      }
     }
   }
-  return nullptr;
+  if (!buffer) {
+    exhausted_count_++;
+    return nullptr;
+  }
+  // The buffer is marked in use, so no other thread touches it while its
+  // surface is reallocated.
+  if (buffer->Reset(width, height)) {
+    reallocation_count_++;
+  }
+  return buffer;
 }
 
 void BufferPool::Release(BufferUnit* buffer) {
@@ -110,10 +205,8 @@ void BufferPool::Release(BufferUnit* buffer) {
 
 void BufferPool::Prepare(int32_t width, int32_t height) {
   std::lock_guard<std::mutex> lock(mutex_);
-  for (size_t index = 0; index < pool_.size(); index++) {
-    BufferUnit* buffer = pool_[index].get();
-    buffer->Reset(width, height);
-  }
+  width_ = width;
+  height_ = height;
 }
 
 SingleBufferPool::SingleBufferPool(int32_t width, int32_t height)
@@ -122,8 +215,19 @@ SingleBufferPool::SingleBufferPool(int32_t width, int32_t height)
 SingleBufferPool::~SingleBufferPool() {}
 
 BufferUnit* SingleBufferPool::GetAvailableBuffer() {
-  BufferUnit* buffer = pool_[0].get();
-  buffer->MarkInUse();
+  int32_t width = 0;
+  int32_t height = 0;
+  BufferUnit* buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    width = width_;
+    height = height_;
+    buffer = pool_[0].get();
+    buffer->MarkInUse();
+  }
+  if (buffer->Reset(width, height)) {
+    reallocation_count_++;
+  }
   return buffer;
 }
 
@@ -8,23 +8,39 @@
 #include <flutter_texture_registrar.h>
 #include <tbm_surface.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <vector>
 
 class BufferUnit {
  public:
-  explicit BufferUnit(int32_t width, int32_t height);
+  explicit BufferUnit(int32_t width, int32_t height,
+                      bool use_external_buffer = false);
   ~BufferUnit();
 
-  void Reset(int32_t width, int32_t height);
+  // Makes the buffer hold frames of |width| x |height|. The surface is
+  // allocated with a margin and reallocated only when the size moves to
+  // another size class. Returns true if the surface was reallocated.
+  bool Reset(int32_t width, int32_t height);
 
   bool MarkInUse();
   void UnmarkInUse();
 
-  bool IsUsed() { return is_used_ && tbm_surface_; }
+  bool IsUsed();
 
-  void UseExternalBuffer();
+  // Called every time the buffer is handed to the engine. The buffer is not
+  // reused until the engine has invoked |release_callback| of the GPU surface
+  // once for each call.
+  void MarkHeldByEngine();
+
+  // Undoes a MarkHeldByEngine() call. Also lets readers other than the engine,
+  // such as snapshots, keep the buffer from being reused while they read it.
+  void ReleaseHold();
+
+  // Takes a reference to |tbm_surface|, which is kept until the buffer is
+  // neither in use nor held by the engine, so that the producer does not
+  // render into it while it is displayed.
   void SetExternalBuffer(tbm_surface_h tbm_surface);
 
   tbm_surface_h Surface();
@@ -37,30 +53,56 @@ class BufferUnit {
 #endif
 
  private:
+  static void OnReleased(void* release_context);
+
+  // Must be called with |mutex_| held.
+  void ReleaseExternalBuffer();
+
+  // Guards |is_used_|, |hold_count_| and an external |tbm_surface_|.
+  std::mutex mutex_;
   bool is_used_ = false;
+  size_t hold_count_ = 0;
   bool use_external_buffer_ = false;
   int32_t width_ = 0;
   int32_t height_ = 0;
+  int32_t allocated_width_ = 0;
+  int32_t allocated_height_ = 0;
   tbm_surface_h tbm_surface_ = nullptr;
   FlutterDesktopGpuSurfaceDescriptor* gpu_surface_ = nullptr;
 };
 
 class BufferPool {
  public:
-  explicit BufferPool(int32_t width, int32_t height, size_t pool_size);
+  // If |use_external_buffer| is true, the buffers do not allocate surfaces
+  // by themselves and only wrap surfaces given by SetExternalBuffer().
+  explicit BufferPool(int32_t width, int32_t height, size_t pool_size,
+                      bool use_external_buffer = false);
   virtual ~BufferPool();
 
   virtual BufferUnit* GetAvailableBuffer();
   virtual void Release(BufferUnit* buffer);
 
-  void Prepare(int32_t with, int32_t height);
+  // Sets the size of the frames to be rendered. Buffers are not touched here
+  // but resized lazily when they are obtained next time, so that a buffer
+  // still read by the engine is never freed.
+  void Prepare(int32_t width, int32_t height);
+
+  // The number of surfaces reallocated because of size changes.
+  size_t reallocation_count() const { return reallocation_count_; }
+
+  // The number of times no buffer was available.
+  size_t exhausted_count() const { return exhausted_count_; }
 
  protected:
   std::vector<std::unique_ptr<BufferUnit>> pool_;
+  std::mutex mutex_;
+  int32_t width_ = 0;
+  int32_t height_ = 0;
+  std::atomic<size_t> reallocation_count_ = 0;
 
  private:
   size_t last_index_ = 0;
-  std::mutex mutex_;
+  std::atomic<size_t> exhausted_count_ = 0;
 };
 
 class SingleBufferPool : public BufferPool {
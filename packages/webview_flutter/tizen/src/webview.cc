@@ -8,8 +8,15 @@
 #include <app_common.h>
 #include <flutter/standard_method_codec.h>
 #include <flutter_texture_registrar.h>
+#include <image_util.h>
 #include <tbm_surface.h>
+#include <tbm_surface_internal.h>
+#include <tizen_error.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <ostream>
 
 #include "buffer_pool.h"
@@ -23,12 +30,48 @@ typedef flutter::MethodCall<flutter::EncodableValue> FlMethodCall;
 typedef flutter::MethodResult<flutter::EncodableValue> FlMethodResult;
 typedef flutter::MethodChannel<flutter::EncodableValue> FlMethodChannel;
 
-constexpr size_t kBufferPoolSize = 5;
+constexpr int32_t kBufferPoolSize = 5;
+constexpr int32_t kMinBufferPoolSize = 2;
+constexpr int32_t kMaxBufferPoolSize = 10;
 constexpr char kEwkInstance[] = "ewk_instance";
+constexpr char kEcoreEvas[] = "ecore_evas";
 constexpr char kTizenWebViewChannelName[] = "plugins.flutter.io/tizen_webview_";
 constexpr char kTizenNavigationDelegateChannelName[] =
     "plugins.flutter.io/tizen_webview_navigation_delegate_";
 
+// Prefixed to a message that carries a JSON array of queued messages.
+constexpr char kJavaScriptChannelBatchMarker = '\x1e';
+
+// Replaces the JavaScript channel object %1$s with one that queues messages
+// and posts them as a single batch once the current script has finished.
+// A microtask is used because animation frames stop in hidden pages.
+constexpr char kJavaScriptChannelQueueScript[] = R"((function() {
+  var channel = window['%1$s'];
+  if (!channel || channel.__isQueued) return;
+  var queue = [];
+  var scheduled = false;
+  var flush = function() {
+    scheduled = false;
+    if (queue.length === 0) return;
+    var batch = queue;
+    queue = [];
+    channel.postMessage('\x1e' + JSON.stringify(batch));
+  };
+  var schedule = function(callback) {
+    Promise.resolve().then(callback);
+  };
+  window['%1$s'] = {
+    __isQueued: true,
+    postMessage: function(message) {
+      queue.push(String(message));
+      if (!scheduled) {
+        scheduled = true;
+        schedule(flush);
+      }
+    }
+  };
+})();)";
+
 class NavigationRequestResult : public FlMethodResult {
  public:
   NavigationRequestResult(WebView* webview) : webview_(webview) {}
@@ -104,23 +147,85 @@ bool GetValueFromEncodableMap(const flutter::EncodableValue* arguments,
   return false;
 }
 
+// Shrinks a BGRA image by an integer |factor| by averaging each block of
+// |factor| x |factor| pixels.
+std::vector<uint8_t> DownscaleBgra(const std::vector<uint8_t>& pixels,
+                                   int32_t width, int32_t height,
+                                   int32_t factor, int32_t* out_width,
+                                   int32_t* out_height) {
+  *out_width = width / factor;
+  *out_height = height / factor;
+  std::vector<uint8_t> output(static_cast<size_t>(*out_width) * *out_height *
+                              4);
+  uint32_t block_size = factor * factor;
+  for (int32_t y = 0; y < *out_height; y++) {
+    for (int32_t x = 0; x < *out_width; x++) {
+      uint32_t sum[4] = {};
+      for (int32_t dy = 0; dy < factor; dy++) {
+        const uint8_t* row =
+            &pixels[((static_cast<size_t>(y) * factor + dy) * width +
+                     static_cast<size_t>(x) * factor) *
+                    4];
+        for (int32_t dx = 0; dx < factor * 4; dx++) {
+          sum[dx % 4] += row[dx];
+        }
+      }
+      uint8_t* out = &output[(static_cast<size_t>(y) * *out_width + x) * 4];
+      for (int32_t channel = 0; channel < 4; channel++) {
+        out[channel] = static_cast<uint8_t>(sum[channel] / block_size);
+      }
+    }
+  }
+  return output;
+}
+
 }  // namespace
 
+struct SnapshotTask {
+  // Null once the webview has been disposed.
+  WebView* webview = nullptr;
+  std::unique_ptr<FlMethodResult> result;
+  // The buffer of the frame, held until the task ends so that no new frame is
+  // put into it while it is copied.
+  BufferUnit* buffer = nullptr;
+  // A reference to the frame, which keeps it alive even if the webview is
+  // disposed first.
+  tbm_surface_h surface = nullptr;
+  // The copied frame in BGRA, without row padding.
+  std::vector<uint8_t> pixels;
+  int32_t width = 0;
+  int32_t height = 0;
+  int32_t max_width = 0;
+  int32_t max_height = 0;
+  int32_t quality = 90;
+  std::vector<uint8_t> encoded;
+  std::string error;
+};
+
 WebView::WebView(flutter::PluginRegistrar* registrar, int view_id,
                  flutter::TextureRegistrar* texture_registrar, double width,
                  double height, const flutter::EncodableValue& params,
-                 void* window)
+                 void* window, Evas_Object* webview_instance)
     : PlatformView(registrar, view_id, nullptr),
       texture_registrar_(texture_registrar),
       width_(width),
       height_(height),
-      window_(window) {
+      window_(window),
+      create_time_(std::chrono::steady_clock::now()),
+      is_prewarmed_(webview_instance != nullptr) {
   if (!EwkInternalApiBinding::GetInstance().Initialize()) {
     LOG_ERROR("Failed to initialize EWK internal APIs.");
     return;
   }
 
-  tbm_pool_ = std::make_unique<SingleBufferPool>(width, height);
+  int32_t buffer_pool_size = kBufferPoolSize;
+  GetValueFromEncodableMap(&params, "bufferPoolSize", &buffer_pool_size);
+  buffer_pool_size = std::clamp(buffer_pool_size, kMinBufferPoolSize,
+                                kMaxBufferPoolSize);
+  // The engine renders into its own surfaces. The pool keeps a reference to
+  // each of them until the raster thread has stopped reading it.
+  tbm_pool_ =
+      std::make_unique<BufferPool>(width, height, buffer_pool_size, true);
 
   texture_variant_ =
       std::make_unique<flutter::TextureVariant>(flutter::GpuSurfaceTexture(
@@ -131,7 +236,7 @@ WebView::WebView(flutter::PluginRegistrar* registrar, int view_id,
           }));
   SetTextureId(texture_registrar_->RegisterTexture(texture_variant_.get()));
 
-  InitWebView();
+  InitWebView(webview_instance);
 
   tizen_webview_channel_ = std::make_unique<FlMethodChannel>(
       GetPluginRegistrar()->messenger(), GetTizenWebViewChannelName(),
@@ -168,6 +273,13 @@ void WebView::RegisterJavaScriptChannelName(const std::string& name) {
       webview_instance_, &WebView::OnJavaScriptMessage, name.c_str());
 }
 
+void WebView::InjectJavaScriptChannelQueue(const std::string& name) {
+  int size = snprintf(nullptr, 0, kJavaScriptChannelQueueScript, name.c_str());
+  std::string script(size, '\0');
+  snprintf(&script[0], size + 1, kJavaScriptChannelQueueScript, name.c_str());
+  ewk_view_script_execute(webview_instance_, script.c_str(), nullptr, nullptr);
+}
+
 WebView::~WebView() { Dispose(); }
 
 std::string WebView::GetTizenWebViewChannelName() {
@@ -181,6 +293,28 @@ std::string WebView::GetNavigationDelegateChannelName() {
 
 void WebView::Dispose() {
   texture_registrar_->UnregisterTexture(GetTextureId());
+  LOG_DEBUG(
+      "Frames rendered: %zu, presented: %zu, skipped: %zu, delayed: %zu, "
+      "hidden: %zu, pool exhausted: %zu",
+      rendered_frame_count_, presented_frame_count_.load(),
+      skipped_frame_count_, delayed_frame_count_, hidden_frame_count_,
+      tbm_pool_ ? tbm_pool_->exhausted_count() : 0);
+
+  if (frame_rate_timer_) {
+    ecore_timer_del(frame_rate_timer_);
+    frame_rate_timer_ = nullptr;
+  }
+  for (SnapshotTask* task : snapshot_tasks_) {
+    task->webview = nullptr;
+  }
+  snapshot_tasks_.clear();
+
+  if (touch_move_animator_) {
+    ecore_animator_del(touch_move_animator_);
+    touch_move_animator_ = nullptr;
+  }
+  eina_list_free(touch_points_);
+  touch_points_ = nullptr;
 
   if (webview_instance_) {
     evas_object_smart_callback_del(webview_instance_,
@@ -199,7 +333,8 @@ void WebView::Dispose() {
     evas_object_smart_callback_del(webview_instance_,
                                    "policy,navigation,decide",
                                    &WebView::OnNavigationPolicy);
-    evas_object_del(webview_instance_);
+    DeleteWebViewInstance(webview_instance_);
+    webview_instance_ = nullptr;
   }
 }
 
@@ -207,8 +342,10 @@ void WebView::Resize(double width, double height) {
   width_ = width;
   height_ = height;
 
-  if (candidate_surface_) {
-    candidate_surface_ = nullptr;
+  // The pending frame has the previous size.
+  BufferUnit* candidate = candidate_surface_.exchange(nullptr);
+  if (candidate) {
+    tbm_pool_->Release(candidate);
   }
 
   tbm_pool_->Prepare(width_, height_);
@@ -217,32 +354,59 @@ void WebView::Resize(double width, double height) {
 
 void WebView::Touch(int type, int button, double x, double y, double dx,
                     double dy) {
-  Ewk_Touch_Event_Type mouse_event_type = EWK_TOUCH_START;
-  Evas_Touch_Point_State state = EVAS_TOUCH_POINT_DOWN;
+  if (type == 1) {  // move event
+    pending_touch_x_ = x;
+    pending_touch_y_ = y;
+    has_pending_touch_move_ = true;
+    if (!touch_move_animator_) {
+      touch_move_animator_ =
+          ecore_animator_add(&WebView::OnTouchMoveFrame, this);
+    }
+    return;
+  }
+
+  // Deliver the last move before the pointer goes up or down again.
+  FlushPendingTouchMove();
   if (type == 0) {  // down event
-    mouse_event_type = EWK_TOUCH_START;
-    state = EVAS_TOUCH_POINT_DOWN;
-  } else if (type == 1) {  // move event
-    mouse_event_type = EWK_TOUCH_MOVE;
-    state = EVAS_TOUCH_POINT_MOVE;
+    FeedTouchEvent(EWK_TOUCH_START, EVAS_TOUCH_POINT_DOWN, x, y);
   } else if (type == 2) {  // up event
-    mouse_event_type = EWK_TOUCH_END;
-    state = EVAS_TOUCH_POINT_UP;
+    FeedTouchEvent(EWK_TOUCH_END, EVAS_TOUCH_POINT_UP, x, y);
   } else {
     LOG_WARN("Unknown touch event type: %d", type);
   }
+}
 
-  Eina_List* points = 0;
-  Ewk_Touch_Point* point = new Ewk_Touch_Point;
-  point->id = 0;
-  point->x = x;
-  point->y = y;
-  point->state = state;
-  points = eina_list_append(points, point);
-
+void WebView::FeedTouchEvent(Ewk_Touch_Event_Type type,
+                             Evas_Touch_Point_State state, double x,
+                             double y) {
+  touch_point_.id = 0;
+  touch_point_.x = x;
+  touch_point_.y = y;
+  touch_point_.state = state;
+  if (!touch_points_) {
+    touch_points_ = eina_list_append(touch_points_, &touch_point_);
+  }
   EwkInternalApiBinding::GetInstance().view.FeedTouchEvent(
-      webview_instance_, mouse_event_type, points, 0);
-  eina_list_free(points);
+      webview_instance_, type, touch_points_, 0);
+}
+
+void WebView::FlushPendingTouchMove() {
+  if (touch_move_animator_) {
+    ecore_animator_del(touch_move_animator_);
+    touch_move_animator_ = nullptr;
+  }
+  if (has_pending_touch_move_) {
+    has_pending_touch_move_ = false;
+    FeedTouchEvent(EWK_TOUCH_MOVE, EVAS_TOUCH_POINT_MOVE, pending_touch_x_,
+                   pending_touch_y_);
+  }
+}
+
+Eina_Bool WebView::OnTouchMoveFrame(void* data) {
+  WebView* webview = static_cast<WebView*>(data);
+  webview->touch_move_animator_ = nullptr;
+  webview->FlushPendingTouchMove();
+  return ECORE_CALLBACK_CANCEL;
 }
 
 bool WebView::SendKey(const char* key, const char* string, const char* compose,
@@ -282,7 +446,13 @@ void WebView::SetDirection(int direction) {
   // TODO: Implement if necessary.
 }
 
-void WebView::InitWebView() {
+void WebView::InitializeEngine() {
+  static bool is_initialized = false;
+  if (is_initialized) {
+    return;
+  }
+  is_initialized = true;
+
   char* chromium_argv[] = {
       const_cast<char*>("--disable-pinch"),
       const_cast<char*>("--js-flags=--expose-gc"),
@@ -292,30 +462,56 @@ void WebView::InitWebView() {
   int chromium_argc = sizeof(chromium_argv) / sizeof(chromium_argv[0]);
   EwkInternalApiBinding::GetInstance().main.SetArguments(chromium_argc,
                                                          chromium_argv);
-
   ewk_init();
+}
+
+Evas_Object* WebView::CreateWebViewInstance(void* window) {
+  InitializeEngine();
   Ecore_Evas* evas = ecore_evas_new("wayland_egl", 0, 0, 1, 1, 0);
+  if (!evas) {
+    LOG_ERROR("Failed to create an Ecore_Evas.");
+    return nullptr;
+  }
 
-  webview_instance_ = ewk_view_add(ecore_evas_get(evas));
+  Evas_Object* webview_instance = ewk_view_add(ecore_evas_get(evas));
+  // Each instance owns its canvas, which is freed with the instance.
+  evas_object_data_set(webview_instance, kEcoreEvas, evas);
   ecore_evas_focus_set(evas, true);
-  ewk_view_focus_set(webview_instance_, true);
+  ewk_view_focus_set(webview_instance, true);
   EwkInternalApiBinding::GetInstance().view.OffscreenRenderingEnabledSet(
-      webview_instance_, true);
+      webview_instance, true);
 
-  Ewk_Context* context = ewk_view_context_get(webview_instance_);
+  Ewk_Context* context = ewk_view_context_get(webview_instance);
   Ewk_Cookie_Manager* cookie_manager = ewk_context_cookie_manager_get(context);
   if (cookie_manager) {
     ewk_cookie_manager_accept_policy_set(
         cookie_manager, EWK_COOKIE_ACCEPT_POLICY_NO_THIRD_PARTY);
   }
-  ewk_context_cache_model_set(context, EWK_CACHE_MODEL_PRIMARY_WEBBROWSER);
 
   EwkInternalApiBinding::GetInstance().settings.ImePanelEnabledSet(
-      ewk_view_settings_get(webview_instance_), true);
-  EwkInternalApiBinding::GetInstance().view.ImeWindowSet(webview_instance_,
-                                                         window_);
+      ewk_view_settings_get(webview_instance), true);
+  EwkInternalApiBinding::GetInstance().view.ImeWindowSet(webview_instance,
+                                                         window);
   EwkInternalApiBinding::GetInstance().view.KeyEventsEnabledSet(
-      webview_instance_, true);
+      webview_instance, true);
+  return webview_instance;
+}
+
+void WebView::DeleteWebViewInstance(Evas_Object* webview_instance) {
+  auto* evas = static_cast<Ecore_Evas*>(
+      evas_object_data_get(webview_instance, kEcoreEvas));
+  evas_object_del(webview_instance);
+  if (evas) {
+    ecore_evas_free(evas);
+  }
+}
+
+void WebView::InitWebView(Evas_Object* webview_instance) {
+  webview_instance_ =
+      webview_instance ? webview_instance : CreateWebViewInstance(window_);
+  if (!webview_instance_) {
+    return;
+  }
 
   evas_object_smart_callback_add(webview_instance_, "offscreen,frame,rendered",
                                  &WebView::OnFrameRendered, this);
@@ -399,13 +595,53 @@ void WebView::HandleTizenWebViewMethodCall(
     } else {
       result->Error("Invalid argument", "The argument must be a string.");
     }
+  } else if (method_name == "runJavaScriptBatch") {
+    const auto* scripts = std::get_if<flutter::EncodableList>(arguments);
+    if (!scripts || scripts->empty()) {
+      result->Error("Invalid argument", "The argument must be a list.");
+      return;
+    }
+    for (const flutter::EncodableValue& script : *scripts) {
+      if (!std::holds_alternative<std::string>(script)) {
+        result->Error("Invalid argument",
+                      "Every script in the list must be a string.");
+        return;
+      }
+    }
+    // Scripts are executed in order, so only the last one needs to report
+    // its completion.
+    for (size_t i = 0; i < scripts->size(); i++) {
+      const auto* javascript = std::get_if<std::string>(&(*scripts)[i]);
+      if (i + 1 < scripts->size()) {
+        ewk_view_script_execute(webview_instance_, javascript->c_str(),
+                                nullptr, nullptr);
+      } else {
+        ewk_view_script_execute(webview_instance_, javascript->c_str(),
+                                &WebView::OnEvaluateJavaScript,
+                                result.release());
+      }
+    }
+    if (result) {
+      result->Success();
+    }
   } else if (method_name == "addJavaScriptChannel") {
-    const auto* channel = std::get_if<std::string>(arguments);
-    if (channel) {
-      RegisterJavaScriptChannelName(*channel);
+    std::string channel;
+    bool batched = false;
+    if (const auto* name = std::get_if<std::string>(arguments)) {
+      channel = *name;
+    } else {
+      GetValueFromEncodableMap(arguments, "name", &channel);
+      GetValueFromEncodableMap(arguments, "batched", &batched);
+    }
+    if (!channel.empty()) {
+      RegisterJavaScriptChannelName(channel);
+      if (batched) {
+        batched_javascript_channels_.insert(channel);
+        InjectJavaScriptChannelQueue(channel);
+      }
       result->Success();
     } else {
-      result->Error("Invalid argument", "The argument must be a string.");
+      result->Error("Invalid argument", "No channel name provided.");
     }
   } else if (method_name == "clearCache") {
     Ewk_Context* context = ewk_view_context_get(webview_instance_);
@@ -487,6 +723,69 @@ void WebView::HandleTizenWebViewMethodCall(
           *color & 0xff, *color >> 24 & 0xff);
       result->Success();
     }
+  } else if (method_name == "setMaxFrameRate") {
+    const auto* frame_rate = std::get_if<int32_t>(arguments);
+    if (frame_rate && *frame_rate >= 0) {
+      max_frame_rate_ = *frame_rate;
+      result->Success();
+    } else {
+      result->Error("Invalid argument",
+                    "The frame rate must be a non-negative integer.");
+    }
+  } else if (method_name == "setVisible") {
+    const auto* visible = std::get_if<bool>(arguments);
+    if (!visible) {
+      result->Error("Invalid argument", "The argument must be a bool.");
+      return;
+    }
+    if (is_visible_ != *visible) {
+      is_visible_ = *visible;
+      // Lets the engine stop rendering while hidden.
+      ewk_view_visibility_set(webview_instance_, is_visible_);
+      if (is_visible_ && candidate_surface_.load()) {
+        MarkFrameAvailable();
+      }
+    }
+    result->Success();
+  } else if (method_name == "setSuspended") {
+    const auto* suspended = std::get_if<bool>(arguments);
+    if (!suspended) {
+      result->Error("Invalid argument", "The argument must be a bool.");
+      return;
+    }
+    if (is_suspended_ != *suspended) {
+      is_suspended_ = *suspended;
+      if (is_suspended_) {
+        ewk_view_suspend(webview_instance_);
+      } else {
+        ewk_view_resume(webview_instance_);
+      }
+    }
+    result->Success();
+  } else if (method_name == "takeSnapshot") {
+    TakeSnapshot(arguments, std::move(result));
+  } else if (method_name == "getFrameCounters") {
+    flutter::EncodableMap counters = {
+        {flutter::EncodableValue("rendered"),
+         flutter::EncodableValue(static_cast<int64_t>(rendered_frame_count_))},
+        {flutter::EncodableValue("presented"),
+         flutter::EncodableValue(
+             static_cast<int64_t>(presented_frame_count_.load()))},
+        {flutter::EncodableValue("skipped"),
+         flutter::EncodableValue(static_cast<int64_t>(skipped_frame_count_))},
+        {flutter::EncodableValue("delayed"),
+         flutter::EncodableValue(static_cast<int64_t>(delayed_frame_count_))},
+        {flutter::EncodableValue("hidden"),
+         flutter::EncodableValue(static_cast<int64_t>(hidden_frame_count_))},
+        {flutter::EncodableValue("poolExhausted"),
+         flutter::EncodableValue(
+             static_cast<int64_t>(tbm_pool_->exhausted_count()))},
+        {flutter::EncodableValue("firstFrameMs"),
+         flutter::EncodableValue(first_frame_time_ms_)},
+        {flutter::EncodableValue("prewarmed"),
+         flutter::EncodableValue(is_prewarmed_ ? 1 : 0)},
+    };
+    result->Success(flutter::EncodableValue(counters));
   } else if (method_name == "userAgent") {
     const auto* userAgent = std::get_if<std::string>(arguments);
     if (userAgent) {
@@ -525,42 +824,223 @@ void WebView::HandleCookieMethodCall(const FlMethodCall& method_call,
 
 FlutterDesktopGpuSurfaceDescriptor* WebView::ObtainGpuSurface(size_t width,
                                                               size_t height) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  if (!candidate_surface_) {
+  std::lock_guard<std::mutex> lock(rendered_surface_mutex_);
+  BufferUnit* candidate = candidate_surface_.exchange(nullptr);
+  if (candidate) {
     if (rendered_surface_) {
-      return rendered_surface_->GpuSurface();
+      // The buffer is reused only after the engine has released it.
+      tbm_pool_->Release(rendered_surface_);
     }
-    return nullptr;
+    rendered_surface_ = candidate;
+    presented_frame_count_++;
   }
-  if (rendered_surface_ && rendered_surface_->IsUsed()) {
-    tbm_pool_->Release(rendered_surface_);
+  if (!rendered_surface_) {
+    return nullptr;
   }
-  rendered_surface_ = candidate_surface_;
-  candidate_surface_ = nullptr;
+  rendered_surface_->MarkHeldByEngine();
   return rendered_surface_->GpuSurface();
 }
 
 void WebView::OnFrameRendered(void* data, Evas_Object* obj, void* event_info) {
-  if (event_info) {
-    WebView* webview = static_cast<WebView*>(data);
+  if (!event_info) {
+    return;
+  }
+  WebView* webview = static_cast<WebView*>(data);
+  webview->rendered_frame_count_++;
+  if (webview->first_frame_time_ms_ < 0) {
+    webview->first_frame_time_ms_ =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - webview->create_time_)
+            .count();
+    LOG_DEBUG("First frame rendered in %lld ms (prewarmed: %d).",
+              static_cast<long long>(webview->first_frame_time_ms_),
+              webview->is_prewarmed_);
+  }
+
+  BufferUnit* buffer = webview->tbm_pool_->GetAvailableBuffer();
+  if (!buffer) {
+    // All buffers are displayed or still read by the engine. The pending
+    // frame has not been picked up yet, so it is dropped and its buffer is
+    // reused. Without a pending frame, this frame is dropped.
+    webview->CountDroppedFrame();
+    buffer = webview->candidate_surface_.exchange(nullptr);
+    if (!buffer) {
+      return;
+    }
+  }
+  // Keeps the engine from rendering into the surface until the raster thread
+  // has released it.
+  buffer->SetExternalBuffer(static_cast<tbm_surface_h>(event_info));
+
+  BufferUnit* previous = webview->candidate_surface_.exchange(buffer);
+  if (previous) {
+    // The previous frame was never displayed.
+    webview->CountDroppedFrame();
+    webview->tbm_pool_->Release(previous);
+  }
+  webview->MarkFrameAvailable();
+}
+
+void WebView::TakeSnapshot(const flutter::EncodableValue* arguments,
+                           std::unique_ptr<FlMethodResult> result) {
+  auto task = std::make_unique<SnapshotTask>();
+  GetValueFromEncodableMap(arguments, "maxWidth", &task->max_width);
+  GetValueFromEncodableMap(arguments, "maxHeight", &task->max_height);
+  GetValueFromEncodableMap(arguments, "quality", &task->quality);
+  task->quality = std::clamp(task->quality, 1, 100);
+
+  {
+    // Only the reference is taken under the lock so that the raster thread
+    // is not blocked by the copy, which is done on the encoding thread.
+    std::lock_guard<std::mutex> lock(rendered_surface_mutex_);
+    if (!rendered_surface_) {
+      result->Error("Snapshot failed", "No frame has been rendered yet.");
+      return;
+    }
+    task->buffer = rendered_surface_;
+    task->buffer->MarkHeldByEngine();
+    task->surface = rendered_surface_->Surface();
+    tbm_surface_internal_ref(task->surface);
+  }
+
+  task->pixels = std::move(snapshot_pixels_);
+  task->webview = this;
+  task->result = std::move(result);
+  SnapshotTask* data = task.release();
+  snapshot_tasks_.insert(data);
+  if (!ecore_thread_run(&WebView::OnSnapshotEncode, &WebView::OnSnapshotEnd,
+                        &WebView::OnSnapshotEnd, data)) {
+    // Already completed through OnSnapshotEnd.
+    LOG_ERROR("Failed to start a snapshot thread.");
+  }
+}
+
+void WebView::OnSnapshotEncode(void* data, Ecore_Thread* thread) {
+  SnapshotTask* task = static_cast<SnapshotTask*>(data);
+  tbm_surface_info_s info;
+  if (tbm_surface_map(task->surface, TBM_SURF_OPTION_READ, &info) !=
+      TBM_SURFACE_ERROR_NONE) {
+    task->error = "Failed to map the frame.";
+    return;
+  }
+  task->width = info.width;
+  task->height = info.height;
+  size_t row_size = static_cast<size_t>(info.width) * 4;
+  task->pixels.resize(row_size * info.height);
+  for (uint32_t row = 0; row < info.height; row++) {
+    memcpy(&task->pixels[row * row_size],
+           info.planes[0].ptr + row * info.planes[0].stride, row_size);
+  }
+  tbm_surface_unmap(task->surface);
+
+  int32_t width = task->width;
+  int32_t height = task->height;
+  int32_t factor = 1;
+  if (task->max_width > 0) {
+    factor = std::max(factor, (width + task->max_width - 1) / task->max_width);
+  }
+  if (task->max_height > 0) {
+    factor =
+        std::max(factor, (height + task->max_height - 1) / task->max_height);
+  }
+  std::vector<uint8_t> scaled;
+  const std::vector<uint8_t>* pixels = &task->pixels;
+  if (factor > 1) {
+    scaled = DownscaleBgra(task->pixels, task->width, task->height, factor,
+                           &width, &height);
+    pixels = &scaled;
+  }
 
-    std::lock_guard<std::mutex> lock(webview->mutex_);
-    if (!webview->working_surface_) {
-      webview->working_surface_ = webview->tbm_pool_->GetAvailableBuffer();
-      webview->working_surface_->UseExternalBuffer();
+  image_util_image_h image = nullptr;
+  int ret = image_util_create_image(width, height,
+                                    IMAGE_UTIL_COLORSPACE_BGRA8888,
+                                    pixels->data(), pixels->size(), &image);
+  if (ret != IMAGE_UTIL_ERROR_NONE) {
+    task->error = get_error_message(ret);
+    return;
+  }
+  image_util_encode_h encoder = nullptr;
+  ret = image_util_encode_create(IMAGE_UTIL_JPEG, &encoder);
+  if (ret == IMAGE_UTIL_ERROR_NONE) {
+    image_util_encode_set_quality(encoder, task->quality);
+    unsigned char* buffer = nullptr;
+    size_t buffer_size = 0;
+    ret = image_util_encode_run_to_buffer(encoder, image, &buffer,
+                                          &buffer_size);
+    if (ret == IMAGE_UTIL_ERROR_NONE) {
+      task->encoded.assign(buffer, buffer + buffer_size);
+      free(buffer);
     }
-    webview->working_surface_->SetExternalBuffer(
-        static_cast<tbm_surface_h>(event_info));
+    image_util_encode_destroy(encoder);
+  }
+  if (ret != IMAGE_UTIL_ERROR_NONE) {
+    task->error = get_error_message(ret);
+  }
+  image_util_destroy_image(image);
+}
+
+void WebView::OnSnapshotEnd(void* data, Ecore_Thread* thread) {
+  std::unique_ptr<SnapshotTask> task(static_cast<SnapshotTask*>(data));
+  tbm_surface_internal_unref(task->surface);
+  if (task->webview) {
+    // The buffer is freed with the webview otherwise.
+    task->buffer->ReleaseHold();
+    task->webview->snapshot_tasks_.erase(task.get());
+    task->webview->snapshot_pixels_ = std::move(task->pixels);
+  }
+  if (!task->encoded.empty()) {
+    task->result->Success(flutter::EncodableValue(std::move(task->encoded)));
+  } else {
+    task->result->Error("Snapshot failed", task->error.empty()
+                                               ? "Encoding was cancelled."
+                                               : task->error);
+  }
+}
 
-    if (webview->candidate_surface_) {
-      webview->tbm_pool_->Release(webview->candidate_surface_);
-      webview->candidate_surface_ = nullptr;
+void WebView::MarkFrameAvailable() {
+  if (!is_visible_) {
+    // The latest frame is kept and presented when the view is shown again.
+    return;
+  }
+  if (frame_rate_timer_) {
+    // The scheduled notification will present the latest frame.
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  if (max_frame_rate_ > 0) {
+    auto interval = std::chrono::duration<double>(1.0 / max_frame_rate_);
+    auto elapsed = now - last_frame_time_;
+    if (elapsed < interval) {
+      frame_rate_timer_ = ecore_timer_add(
+          std::chrono::duration<double>(interval - elapsed).count(),
+          &WebView::OnFrameRateTimer, this);
+      return;
     }
-    webview->candidate_surface_ = webview->working_surface_;
-    webview->working_surface_ = nullptr;
+  }
+  last_frame_time_ = now;
+  texture_registrar_->MarkTextureFrameAvailable(GetTextureId());
+}
+
+void WebView::CountDroppedFrame() {
+  if (!is_visible_) {
+    hidden_frame_count_++;
+  } else if (frame_rate_timer_) {
+    delayed_frame_count_++;
+  } else {
+    skipped_frame_count_++;
+  }
+}
+
+Eina_Bool WebView::OnFrameRateTimer(void* data) {
+  WebView* webview = static_cast<WebView*>(data);
+  webview->frame_rate_timer_ = nullptr;
+  if (webview->is_visible_) {
+    webview->last_frame_time_ = std::chrono::steady_clock::now();
     webview->texture_registrar_->MarkTextureFrameAvailable(
         webview->GetTextureId());
   }
+  return ECORE_CALLBACK_CANCEL;
 }
 
 void WebView::OnLoadStarted(void* data, Evas_Object* obj, void* event_info) {
@@ -574,6 +1054,9 @@ void WebView::OnLoadStarted(void* data, Evas_Object* obj, void* event_info) {
 
 void WebView::OnLoadFinished(void* data, Evas_Object* obj, void* event_info) {
   WebView* webview = static_cast<WebView*>(data);
+  for (const std::string& channel : webview->batched_javascript_channels_) {
+    webview->InjectJavaScriptChannelQueue(channel);
+  }
   std::string url = std::string(ewk_view_url_get(webview->webview_instance_));
   flutter::EncodableMap args = {
       {flutter::EncodableValue("url"), flutter::EncodableValue(url)}};
@@ -672,6 +1155,20 @@ void WebView::OnJavaScriptMessage(Evas_Object* obj,
       std::string channel_name(message.name);
       std::string message_body(static_cast<char*>(message.body));
 
+      if (!message_body.empty() &&
+          message_body[0] == kJavaScriptChannelBatchMarker &&
+          webview->batched_javascript_channels_.count(channel_name)) {
+        // The batch is decoded on the Dart side in one go.
+        flutter::EncodableList args = {
+            flutter::EncodableValue(std::move(channel_name)),
+            flutter::EncodableValue(message_body.substr(1)),
+        };
+        webview->tizen_webview_channel_->InvokeMethod(
+            "javaScriptChannelMessages",
+            std::make_unique<flutter::EncodableValue>(std::move(args)));
+        return;
+      }
+
       flutter::EncodableMap args = {
           {flutter::EncodableValue("channel"),
            flutter::EncodableValue(channel_name)},
@@ -6,6 +6,7 @@
 #define FLUTTER_PLUGIN_WEBVIEW_H_
 
 #include <EWebKit.h>
+#include <Ecore.h>
 #include <Evas.h>
 #include <flutter/encodable_value.h>
 #include <flutter/method_channel.h>
@@ -14,21 +15,38 @@
 #include <flutter/texture_registrar.h>
 #include <flutter_platform_view.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <vector>
 
 class BufferPool;
 class BufferUnit;
+struct SnapshotTask;
 
 class WebView : public PlatformView {
  public:
   WebView(flutter::PluginRegistrar* registrar, int view_id,
           flutter::TextureRegistrar* texture_registrar, double width,
-          double height, const flutter::EncodableValue& params, void* window);
+          double height, const flutter::EncodableValue& params, void* window,
+          Evas_Object* webview_instance = nullptr);
   ~WebView();
 
+  // Initializes the web engine once per process.
+  static void InitializeEngine();
+
+  // Creates a blank webview instance which is not bound to any WebView yet.
+  // The instance can be passed to the constructor later.
+  static Evas_Object* CreateWebViewInstance(void* window);
+
+  // Deletes an instance created by CreateWebViewInstance() together with its
+  // canvas.
+  static void DeleteWebViewInstance(Evas_Object* webview_instance);
+
   virtual void Dispose() override;
 
   virtual void Resize(double width, double height) override;
@@ -60,10 +78,29 @@ class WebView : public PlatformView {
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
   void RegisterJavaScriptChannelName(const std::string& name);
+  void InjectJavaScriptChannelQueue(const std::string& name);
   std::string GetTizenWebViewChannelName();
   std::string GetNavigationDelegateChannelName();
 
-  void InitWebView();
+  void InitWebView(Evas_Object* webview_instance);
+
+  void TakeSnapshot(
+      const flutter::EncodableValue* arguments,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  static void OnSnapshotEncode(void* data, Ecore_Thread* thread);
+  static void OnSnapshotEnd(void* data, Ecore_Thread* thread);
+
+  // Notifies Flutter of a new frame, subject to the render policies.
+  void MarkFrameAvailable();
+  // Counts a frame that is dropped without being presented, in the counter of
+  // the reason it was still pending.
+  void CountDroppedFrame();
+  static Eina_Bool OnFrameRateTimer(void* data);
+
+  void FeedTouchEvent(Ewk_Touch_Event_Type type, Evas_Touch_Point_State state,
+                      double x, double y);
+  void FlushPendingTouchMove();
+  static Eina_Bool OnTouchMoveFrame(void* data);
 
   static void OnFrameRendered(void* data, Evas_Object* obj, void* event_info);
   static void OnLoadStarted(void* data, Evas_Object* obj, void* event_info);
@@ -82,16 +119,54 @@ class WebView : public PlatformView {
   double width_ = 0.0;
   double height_ = 0.0;
   void* window_ = nullptr;
-  BufferUnit* working_surface_ = nullptr;
-  BufferUnit* candidate_surface_ = nullptr;
+  std::chrono::steady_clock::time_point create_time_;
+  // The time from construction to the first rendered frame, or -1.
+  int64_t first_frame_time_ms_ = -1;
+  bool is_prewarmed_ = false;
+  // Reused for every touch event. |touch_points_| only refers to it.
+  Ewk_Touch_Point touch_point_ = {};
+  Eina_List* touch_points_ = nullptr;
+  // Move events are coalesced and fed once per frame.
+  Ecore_Animator* touch_move_animator_ = nullptr;
+  bool has_pending_touch_move_ = false;
+  double pending_touch_x_ = 0.0;
+  double pending_touch_y_ = 0.0;
+  // The latest frame that has not been picked up by the raster thread yet.
+  std::atomic<BufferUnit*> candidate_surface_ = nullptr;
+  // The frame being displayed. Written by the raster thread.
   BufferUnit* rendered_surface_ = nullptr;
+  // Guards |rendered_surface_| against being replaced while a snapshot takes
+  // a reference to it.
+  std::mutex rendered_surface_mutex_;
+  // Reused by snapshots, unless a previous snapshot is still being encoded.
+  std::vector<uint8_t> snapshot_pixels_;
+  std::set<SnapshotTask*> snapshot_tasks_;
+  // Every rendered frame is either presented, pending, or dropped and counted
+  // in exactly one of the skipped, delayed and hidden counters.
+  size_t rendered_frame_count_ = 0;
+  std::atomic<size_t> presented_frame_count_ = 0;
+  // Frames dropped because a newer frame replaced them before the raster
+  // thread picked them up.
+  size_t skipped_frame_count_ = 0;
+  // Frames dropped while held back by the frame rate cap.
+  size_t delayed_frame_count_ = 0;
+  // Frames dropped while the view was hidden.
+  size_t hidden_frame_count_ = 0;
+  // 0 means unlimited.
+  int32_t max_frame_rate_ = 0;
+  std::chrono::steady_clock::time_point last_frame_time_;
+  Ecore_Timer* frame_rate_timer_ = nullptr;
+  bool is_visible_ = true;
+  bool is_suspended_ = false;
   bool has_navigation_delegate_ = false;
+  // JavaScript channels whose messages are queued on the page and posted
+  // once per task.
+  std::set<std::string> batched_javascript_channels_;
   std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
       tizen_webview_channel_;
   std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
       navigation_delegate_channel_;
   std::unique_ptr<flutter::TextureVariant> texture_variant_;
-  std::mutex mutex_;
   std::unique_ptr<BufferPool> tbm_pool_;
 };
 
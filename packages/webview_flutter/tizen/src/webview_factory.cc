@@ -7,23 +7,248 @@
 #include <app_common.h>
 #include <flutter/encodable_value.h>
 #include <flutter/message_codec.h>
+#include <flutter/standard_method_codec.h>
 
+#include <algorithm>
 #include <string>
 #include <variant>
 
+#include "ewk_internal_api_binding.h"
 #include "log.h"
 #include "webview.h"
 
+namespace {
+
+constexpr char kWebViewFactoryChannelName[] =
+    "plugins.flutter.io/tizen_webview_factory";
+constexpr size_t kMaxWarmUpPoolSize = 3;
+
+}  // namespace
+
+bool WebViewFactory::is_cache_configuration_applied_ = false;
+
 WebViewFactory::WebViewFactory(flutter::PluginRegistrar* registrar,
                                void* window)
     : PlatformViewFactory(registrar), window_(window) {
   texture_registrar_ = registrar->texture_registrar();
+
+  channel_ = std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+      registrar->messenger(), kWebViewFactoryChannelName,
+      &flutter::StandardMethodCodec::GetInstance());
+  channel_->SetMethodCallHandler([this](const auto& call, auto result) {
+    HandleMethodCall(call, std::move(result));
+  });
 }
 
 PlatformView* WebViewFactory::Create(int view_id, double width, double height,
                                      const ByteMessage& params) {
+  if (EwkInternalApiBinding::GetInstance().Initialize()) {
+    ApplyCacheConfiguration();
+  }
+
+  Evas_Object* webview_instance = nullptr;
+  if (!warm_instances_.empty()) {
+    webview_instance = warm_instances_.front();
+    warm_instances_.pop_front();
+    ScheduleWarmUp();
+  }
   return new WebView(GetPluginRegistrar(), view_id, texture_registrar_, width,
-                     height, *GetCodec().DecodeMessage(params), window_);
+                     height, *GetCodec().DecodeMessage(params), window_,
+                     webview_instance);
+}
+
+void WebViewFactory::Dispose() {
+  channel_->SetMethodCallHandler(nullptr);
+
+  if (warm_up_idler_) {
+    ecore_idler_del(warm_up_idler_);
+    warm_up_idler_ = nullptr;
+  }
+  for (Evas_Object* webview_instance : warm_instances_) {
+    WebView::DeleteWebViewInstance(webview_instance);
+  }
+  warm_instances_.clear();
+
+  prefetch_urls_.clear();
+  if (prefetch_job_) {
+    ecore_job_del(prefetch_job_);
+    prefetch_job_ = nullptr;
+  }
+  if (prefetch_instance_) {
+    WebView::DeleteWebViewInstance(prefetch_instance_);
+    prefetch_instance_ = nullptr;
+  }
+}
+
+void WebViewFactory::HandleMethodCall(
+    const flutter::MethodCall<flutter::EncodableValue>& method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const std::string& method_name = method_call.method_name();
+  const flutter::EncodableValue* arguments = method_call.arguments();
+
+  if (method_name == "setWarmUpPoolSize") {
+    const auto* size = std::get_if<int32_t>(arguments);
+    if (!size || *size < 0) {
+      result->Error("Invalid argument", "The pool size must be non-negative.");
+      return;
+    }
+    SetWarmUpPoolSize(static_cast<size_t>(*size));
+    result->Success();
+  } else if (method_name == "setCacheConfiguration") {
+    const auto* configuration = std::get_if<flutter::EncodableMap>(arguments);
+    if (!configuration) {
+      result->Error("Invalid argument", "The argument must be a map.");
+      return;
+    }
+    if (!EwkInternalApiBinding::GetInstance().Initialize()) {
+      result->Error("Operation failed",
+                    "Failed to initialize EWK internal APIs.");
+      return;
+    }
+    SetCacheConfiguration(*configuration);
+    result->Success();
+  } else {
+    result->NotImplemented();
+  }
+}
+
+void WebViewFactory::SetWarmUpPoolSize(size_t size) {
+  warm_up_pool_size_ = std::min(size, kMaxWarmUpPoolSize);
+  while (warm_instances_.size() > warm_up_pool_size_) {
+    WebView::DeleteWebViewInstance(warm_instances_.back());
+    warm_instances_.pop_back();
+  }
+  ScheduleWarmUp();
 }
 
-void WebViewFactory::Dispose() {}
+void WebViewFactory::ScheduleWarmUp() {
+  if (warm_up_idler_ || warm_instances_.size() >= warm_up_pool_size_) {
+    return;
+  }
+  warm_up_idler_ = ecore_idler_add(&WebViewFactory::OnIdle, this);
+}
+
+Eina_Bool WebViewFactory::OnIdle(void* data) {
+  auto* self = static_cast<WebViewFactory*>(data);
+  if (self->warm_instances_.size() >= self->warm_up_pool_size_) {
+    self->warm_up_idler_ = nullptr;
+    return ECORE_CALLBACK_CANCEL;
+  }
+  if (!EwkInternalApiBinding::GetInstance().Initialize()) {
+    LOG_ERROR("Failed to initialize EWK internal APIs.");
+    self->warm_up_idler_ = nullptr;
+    return ECORE_CALLBACK_CANCEL;
+  }
+  self->ApplyCacheConfiguration();
+
+  // Create one instance per idle callback so that the main loop is not
+  // blocked for long.
+  Evas_Object* webview_instance = WebView::CreateWebViewInstance(self->window_);
+  if (webview_instance) {
+    self->warm_instances_.push_back(webview_instance);
+  }
+  if (!webview_instance ||
+      self->warm_instances_.size() >= self->warm_up_pool_size_) {
+    self->warm_up_idler_ = nullptr;
+    return ECORE_CALLBACK_CANCEL;
+  }
+  return ECORE_CALLBACK_RENEW;
+}
+
+void WebViewFactory::ApplyCacheConfiguration() {
+  if (is_cache_configuration_applied_) {
+    return;
+  }
+  is_cache_configuration_applied_ = true;
+
+  WebView::InitializeEngine();
+  Ewk_Context* context = ewk_context_default_get();
+  ewk_context_cache_model_set(context, cache_model_);
+}
+
+void WebViewFactory::SetCacheConfiguration(
+    const flutter::EncodableMap& configuration) {
+  for (const auto& [key, value] : configuration) {
+    if (!std::holds_alternative<std::string>(key)) {
+      continue;
+    }
+    const std::string& name = std::get<std::string>(key);
+    if (name == "cacheModel" && std::holds_alternative<std::string>(value)) {
+      const std::string& model = std::get<std::string>(value);
+      Ewk_Cache_Model cache_model = EWK_CACHE_MODEL_PRIMARY_WEBBROWSER;
+      if (model == "documentViewer") {
+        cache_model = EWK_CACHE_MODEL_DOCUMENT_VIEWER;
+      } else if (model == "documentBrowser") {
+        cache_model = EWK_CACHE_MODEL_DOCUMENT_BROWSER;
+      }
+      if (is_cache_configuration_applied_) {
+        if (cache_model != cache_model_) {
+          LOG_WARN("The cache model has already been applied; ignored.");
+        }
+      } else {
+        cache_model_ = cache_model;
+      }
+    } else if (name == "prefetchUrls" &&
+               std::holds_alternative<flutter::EncodableList>(value)) {
+      for (const auto& url : std::get<flutter::EncodableList>(value)) {
+        if (std::holds_alternative<std::string>(url)) {
+          prefetch_urls_.push_back(std::get<std::string>(url));
+        }
+      }
+    }
+  }
+  ApplyCacheConfiguration();
+
+  if (!prefetch_instance_ && !prefetch_urls_.empty()) {
+    prefetch_instance_ = WebView::CreateWebViewInstance(window_);
+    if (!prefetch_instance_) {
+      prefetch_urls_.clear();
+      return;
+    }
+    evas_object_smart_callback_add(prefetch_instance_, "load,finished",
+                                   &WebViewFactory::OnPrefetchLoaded, this);
+    evas_object_smart_callback_add(prefetch_instance_, "load,error",
+                                   &WebViewFactory::OnPrefetchLoaded, this);
+    prefetched_url_count_ = 0;
+    prefetch_start_time_ = std::chrono::steady_clock::now();
+    PrefetchNext();
+  }
+}
+
+void WebViewFactory::PrefetchNext() {
+  if (prefetch_urls_.empty()) {
+    LOG_INFO("Prefetched %zu URLs in %lld ms.", prefetched_url_count_,
+             static_cast<long long>(
+                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - prefetch_start_time_)
+                     .count()));
+    // Not called from a callback of the instance, so it can be deleted here.
+    WebView::DeleteWebViewInstance(prefetch_instance_);
+    prefetch_instance_ = nullptr;
+    return;
+  }
+  std::string url = prefetch_urls_.front();
+  prefetch_urls_.pop_front();
+  prefetched_url_count_++;
+  is_prefetch_loading_ = true;
+  ewk_view_url_set(prefetch_instance_, url.c_str());
+}
+
+void WebViewFactory::OnPrefetchLoaded(void* data, Evas_Object* obj,
+                                      void* event_info) {
+  auto* self = static_cast<WebViewFactory*>(data);
+  if (obj != self->prefetch_instance_ || !self->is_prefetch_loading_) {
+    // The other end event of a load that has already been handled.
+    return;
+  }
+  self->is_prefetch_loading_ = false;
+  // Deferred so that both end events of the load are handled before the next
+  // URL starts loading.
+  self->prefetch_job_ = ecore_job_add(
+      [](void* data) {
+        auto* self = static_cast<WebViewFactory*>(data);
+        self->prefetch_job_ = nullptr;
+        self->PrefetchNext();
+      },
+      self);
+}
@@ -5,10 +5,19 @@
 #ifndef FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
 #define FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
 
+#include <EWebKit.h>
+#include <Ecore.h>
+#include <Evas.h>
+#include <flutter/encodable_value.h>
+#include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
 #include <flutter/texture_registrar.h>
 #include <flutter_platform_view.h>
 
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
 #include <vector>
 
 class WebViewFactory : public PlatformViewFactory {
@@ -21,8 +30,47 @@ class WebViewFactory : public PlatformViewFactory {
   virtual void Dispose() override;
 
  private:
+  void HandleMethodCall(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+  // Sets the number of blank webview instances kept ready for Create().
+  void SetWarmUpPoolSize(size_t size);
+  // Schedules creating instances at idle time until the pool is full.
+  void ScheduleWarmUp();
+
+  static Eina_Bool OnIdle(void* data);
+
+  // Applies the cache configuration to the context shared by all webviews.
+  // Only the first call in the process has an effect.
+  void ApplyCacheConfiguration();
+  void SetCacheConfiguration(const flutter::EncodableMap& configuration);
+
+  // Loads |prefetch_urls_| one by one in a hidden instance so that their
+  // resources are in the shared cache when a webview opens them.
+  void PrefetchNext();
+  // Called on both "load,finished" and "load,error", which may both be
+  // emitted for one load.
+  static void OnPrefetchLoaded(void* data, Evas_Object* obj, void* event_info);
+
   flutter::TextureRegistrar* texture_registrar_;
   void* window_ = nullptr;
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>> channel_;
+  std::deque<Evas_Object*> warm_instances_;
+  size_t warm_up_pool_size_ = 0;
+  Ecore_Idler* warm_up_idler_ = nullptr;
+  Ewk_Cache_Model cache_model_ = EWK_CACHE_MODEL_PRIMARY_WEBBROWSER;
+  // The default context is shared by the whole process.
+  static bool is_cache_configuration_applied_;
+  Evas_Object* prefetch_instance_ = nullptr;
+  std::deque<std::string> prefetch_urls_;
+  // Whether |prefetch_instance_| is loading a URL whose end has not been
+  // handled yet.
+  bool is_prefetch_loading_ = false;
+  // Advances to the next URL once the events of the current load are done.
+  Ecore_Job* prefetch_job_ = nullptr;
+  size_t prefetched_url_count_ = 0;
+  std::chrono::steady_clock::time_point prefetch_start_time_;
 };
 
 #endif  // FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
@@ -18,12 +18,47 @@ import 'package:webview_flutter_platform_interface/webview_flutter_platform_inte
 /// This is used as the default implementation for [WebView.platform] on Tizen. It uses a method channel to
 /// communicate with the platform code.
 class LweWebView implements WebViewPlatform {
+  /// Creates a [LweWebView].
+  ///
+  /// [bufferPoolSize] is the number of buffers used to pass rendered frames
+  /// to Flutter by web views built with this platform. More buffers make it
+  /// less likely that a frame is skipped because all buffers are busy, at the
+  /// cost of memory. The pool also grows by itself, up to twice this size, if
+  /// it keeps running out of buffers. Values are clamped to the range 2 to 10.
+  /// Defaults to 5 when null.
+  ///
+  /// [maxFrameRate] limits how many frames per second web views built with
+  /// this platform present, which saves GPU and CPU time when the content
+  /// animates faster than needed. Unlimited when null.
+  LweWebView({this.bufferPoolSize, this.maxFrameRate});
+
   /// Sets a tizen [WebViewPlatform].
   static void register() {
     WebView.platform = LweWebView();
     WebViewCookieManagerPlatform.instance = WebViewTizenCookieManager();
   }
 
+  static const MethodChannel _factoryChannel =
+      MethodChannel('plugins.flutter.io/webview_lwe_factory');
+
+  /// Sets the directory where the HTTP cache of web views is stored.
+  ///
+  /// The cache is shared by all web views and persists across app launches,
+  /// so resources loaded once are not downloaded again when a page is opened
+  /// next time. Defaults to the app data directory.
+  ///
+  /// The engine is initialized only once per process, so this must be called
+  /// before the first web view is created.
+  static Future<void> setCacheDirectory(String path) {
+    return _factoryChannel.invokeMethod<void>('setCacheDirectory', path);
+  }
+
+  /// The initial number of render buffers of each web view.
+  final int? bufferPoolSize;
+
+  /// The maximum number of frames presented per second by each web view.
+  final int? maxFrameRate;
+
   @override
   Widget build({
     required BuildContext context,
@@ -51,8 +86,11 @@ class LweWebView implements WebViewPlatform {
         },
         gestureRecognizers: gestureRecognizers,
         layoutDirection: Directionality.maybeOf(context) ?? TextDirection.rtl,
-        creationParams:
-            MethodChannelWebViewPlatform.creationParamsToMap(creationParams),
+        creationParams: <String, dynamic>{
+          ...MethodChannelWebViewPlatform.creationParamsToMap(creationParams),
+          if (bufferPoolSize != null) 'bufferPoolSize': bufferPoolSize,
+          if (maxFrameRate != null) 'maxFrameRate': maxFrameRate,
+        },
         creationParamsCodec: const StandardMessageCodec(),
       ),
     );
@@ -4,9 +4,38 @@
 
 #include "buffer_pool.h"
 
+#include <algorithm>
+
 #include "log.h"
 
-BufferUnit::BufferUnit(int32_t width, int32_t height) { Reset(width, height); }
+namespace {
+
+// Surfaces are allocated in steps of this size so that small size changes,
+// e.g. during an animated layout change, do not reallocate them.
+constexpr int32_t kSizeClassStep = 128;
+
+// The pool grows after this many shortages.
+constexpr size_t kGrowThreshold = 3;
+
+// A grown pool frees one extra buffer after this many frames without
+// shortage, i.e. about 5 seconds at 60 fps.
+constexpr size_t kShrinkAfterFrames = 300;
+
+// The total size of buffers above which the pool does not grow.
+constexpr size_t kMaxPoolMemoryBytes = 128 * 1024 * 1024;
+
+int32_t RoundUpToSizeClass(int32_t size) {
+  return (size + kSizeClassStep - 1) / kSizeClassStep * kSizeClassStep;
+}
+
+}  // namespace
+
+BufferUnit::BufferUnit(int32_t width, int32_t height) {
+  gpu_surface_ = new FlutterDesktopGpuSurfaceDescriptor();
+  gpu_surface_->release_callback = &BufferUnit::OnReleased;
+  gpu_surface_->release_context = this;
+  Reset(width, height);
+}
 
 BufferUnit::~BufferUnit() {
   if (tbm_surface_) {
@@ -20,7 +49,7 @@ BufferUnit::~BufferUnit() {
 }
 
 bool BufferUnit::MarkInUse() {
-  if (!is_used_) {
+  if (!is_used_ && hold_count_ == 0) {
     is_used_ = true;
     return true;
   }
@@ -36,51 +65,133 @@ tbm_surface_h BufferUnit::Surface() {
   return nullptr;
 }
 
-void BufferUnit::Reset(int32_t width, int32_t height) {
+bool BufferUnit::Reset(int32_t width, int32_t height) {
   if (width_ == width && height_ == height) {
-    return;
+    return false;
   }
   width_ = width;
   height_ = height;
+  gpu_surface_->visible_width = width_;
+  gpu_surface_->visible_height = height_;
+
+  int32_t allocated_width = RoundUpToSizeClass(width_);
+  int32_t allocated_height = RoundUpToSizeClass(height_);
+  if (tbm_surface_ && allocated_width_ == allocated_width &&
+      allocated_height_ == allocated_height) {
+    return false;
+  }
+  allocated_width_ = allocated_width;
+  allocated_height_ = allocated_height;
 
   if (tbm_surface_) {
     tbm_surface_destroy(tbm_surface_);
     tbm_surface_ = nullptr;
   }
-  if (gpu_surface_) {
-    delete gpu_surface_;
-    gpu_surface_ = nullptr;
+  tbm_surface_ = tbm_surface_create(allocated_width_, allocated_height_,
+                                    TBM_FORMAT_ARGB8888);
+  if (!tbm_surface_) {
+    LOG_ERROR("Failed to create a tbm surface of %d x %d.", allocated_width_,
+              allocated_height_);
+    allocated_width_ = 0;
+    allocated_height_ = 0;
   }
-
-  tbm_surface_ = tbm_surface_create(width_, height_, TBM_FORMAT_ARGB8888);
-  gpu_surface_ = new FlutterDesktopGpuSurfaceDescriptor();
-  gpu_surface_->width = width_;
-  gpu_surface_->height = height_;
+  gpu_surface_->width = allocated_width_;
+  gpu_surface_->height = allocated_height_;
   gpu_surface_->handle = tbm_surface_;
-  gpu_surface_->release_callback = [](void* release_context) {
-    BufferUnit* buffer = reinterpret_cast<BufferUnit*>(release_context);
-    buffer->UnmarkInUse();
-  };
-  gpu_surface_->release_context = this;
+  return true;
+}
+
+void BufferUnit::OnReleased(void* release_context) {
+  BufferUnit* buffer = reinterpret_cast<BufferUnit*>(release_context);
+  if (buffer->hold_count_-- <= 0) {
+    LOG_ERROR("Released a buffer that is not held by the engine.");
+    buffer->hold_count_ = 0;
+  }
 }
 
-BufferPool::BufferPool(int32_t width, int32_t height, size_t pool_size) {
+BufferPool::BufferPool(int32_t width, int32_t height, size_t pool_size,
+                       size_t max_pool_size)
+    : width_(width),
+      height_(height),
+      min_pool_size_(pool_size),
+      max_pool_size_(std::max(pool_size, max_pool_size)) {
   for (size_t index = 0; index < pool_size; index++) {
     pool_.emplace_back(std::make_unique<BufferUnit>(width, height));
   }
-  Prepare(width, height);
 }
 
 BufferPool::~BufferPool() {}
 
 BufferUnit* BufferPool::GetAvailableBuffer() {
+  int32_t width = 0;
+  int32_t height = 0;
+  BufferUnit* buffer = nullptr;
+  // Freed after the lock is released.
+  std::unique_ptr<BufferUnit> removed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    width = width_;
+    height = height_;
+    for (size_t index = 0; index < pool_.size(); index++) {
+      size_t current = (index + last_index_) % pool_.size();
+      if (pool_[current]->MarkInUse()) {
+        buffer = pool_[current].get();
+        last_index_ = current;
+        if (pool_.size() > min_pool_size_ &&
+            ++frames_since_exhausted_ >= kShrinkAfterFrames) {
+          removed = TryShrink(buffer);
+        }
+        break;
+      }
+    }
+  }
+  if (buffer) {
+    // The buffer is marked in use, so it is neither handed out again nor
+    // freed by TryShrink() while its surface is reallocated.
+    ResetBuffer(buffer, width, height);
+    return buffer;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exhausted_count_++;
+    frames_since_exhausted_ = 0;
+    if (++recent_exhausted_count_ < kGrowThreshold || !CanGrow()) {
+      return nullptr;
+    }
+    recent_exhausted_count_ = 0;
+  }
+
+  // Allocated without the lock. Only the render thread adds buffers.
+  auto unit = std::make_unique<BufferUnit>(width, height);
+  buffer = unit.get();
+  buffer->MarkInUse();
   std::lock_guard<std::mutex> lock(mutex_);
-  for (size_t index = 0; index < pool_.size(); index++) {
-    size_t current = (index + last_index_) % pool_.size();
-    BufferUnit* buffer = pool_[current].get();
-    if (buffer->MarkInUse()) {
-      last_index_ = current;
-      return buffer;
+  pool_.push_back(std::move(unit));
+  LOG_DEBUG("Grew the buffer pool to %zu buffers.", pool_.size());
+  return buffer;
+}
+
+bool BufferPool::CanGrow() {
+  if (pool_.size() >= max_pool_size_) {
+    return false;
+  }
+  size_t buffer_bytes = static_cast<size_t>(RoundUpToSizeClass(width_)) *
+                        RoundUpToSizeClass(height_) * 4;
+  return (pool_.size() + 1) * buffer_bytes <= kMaxPoolMemoryBytes;
+}
+
+std::unique_ptr<BufferUnit> BufferPool::TryShrink(const BufferUnit* keep) {
+  frames_since_exhausted_ = 0;
+  recent_exhausted_count_ = 0;
+  for (size_t index = pool_.size(); index-- > 0;) {
+    BufferUnit* buffer = pool_[index].get();
+    if (buffer != keep && !buffer->IsUsed() && !buffer->IsHeldByEngine()) {
+      std::unique_ptr<BufferUnit> removed = std::move(pool_[index]);
+      pool_.erase(pool_.begin() + index);
+      last_index_ %= pool_.size();
+      LOG_DEBUG("Shrank the buffer pool to %zu buffers.", pool_.size());
+      return removed;
     }
   }
   return nullptr;
@@ -93,9 +204,23 @@ void BufferPool::Release(BufferUnit* buffer) {
 
 void BufferPool::Prepare(int32_t width, int32_t height) {
   std::lock_guard<std::mutex> lock(mutex_);
-  for (size_t index = 0; index < pool_.size(); index++) {
-    BufferUnit* buffer = pool_[index].get();
-    buffer->Reset(width, height);
+  width_ = width;
+  height_ = height;
+}
+
+void BufferPool::ResetBuffer(BufferUnit* buffer, int32_t width,
+                             int32_t height) {
+  auto start = std::chrono::steady_clock::now();
+  if (!buffer->Reset(width, height)) {
+    return;
+  }
+  int64_t elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  reallocation_count_++;
+  reallocation_time_us_ += elapsed_us;
+  if (elapsed_us > max_reallocation_time_us_) {
+    max_reallocation_time_us_ = elapsed_us;
   }
 }
 
@@ -105,8 +230,17 @@ SingleBufferPool::SingleBufferPool(int32_t width, int32_t height)
 SingleBufferPool::~SingleBufferPool() {}
 
 BufferUnit* SingleBufferPool::GetAvailableBuffer() {
-  BufferUnit* buffer = pool_[0].get();
-  buffer->MarkInUse();
+  int32_t width = 0;
+  int32_t height = 0;
+  BufferUnit* buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    width = width_;
+    height = height_;
+    buffer = pool_[0].get();
+    buffer->MarkInUse();
+  }
+  ResetBuffer(buffer, width, height);
   return buffer;
 }
 
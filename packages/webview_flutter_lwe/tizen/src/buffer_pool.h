@@ -8,6 +8,8 @@
 #include <flutter_texture_registrar.h>
 #include <tbm_surface.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -17,13 +19,23 @@ class BufferUnit {
   explicit BufferUnit(int32_t width, int32_t height);
   ~BufferUnit();
 
-  void Reset(int32_t width, int32_t height);
+  // Makes the buffer hold frames of |width| x |height|. The surface is
+  // allocated with a margin and reallocated only when the size moves to
+  // another size class. Returns true if the surface was reallocated.
+  bool Reset(int32_t width, int32_t height);
 
   bool MarkInUse();
   void UnmarkInUse();
 
   bool IsUsed() { return is_used_ && tbm_surface_; }
 
+  // Called every time the buffer is handed to the engine. The buffer is not
+  // reused until the engine has invoked |release_callback| of the GPU surface
+  // once for each call.
+  void MarkHeldByEngine() { hold_count_++; }
+
+  bool IsHeldByEngine() { return hold_count_ > 0; }
+
   tbm_surface_h Surface();
 
   FlutterDesktopGpuSurfaceDescriptor* GpuSurface() { return gpu_surface_; }
@@ -34,29 +46,83 @@ class BufferUnit {
 #endif
 
  private:
+  static void OnReleased(void* release_context);
+
   bool is_used_ = false;
+  std::atomic<int32_t> hold_count_ = 0;
   int32_t width_ = 0;
   int32_t height_ = 0;
+  int32_t allocated_width_ = 0;
+  int32_t allocated_height_ = 0;
   tbm_surface_h tbm_surface_ = nullptr;
   FlutterDesktopGpuSurfaceDescriptor* gpu_surface_ = nullptr;
 };
 
+// A pool of render buffers.
+//
+// If |max_pool_size| is larger than |pool_size|, the pool grows by one buffer
+// whenever it runs out of buffers repeatedly, as long as the total size of the
+// buffers stays under a memory cap. Buffers added this way are freed again
+// after a while without shortage.
 class BufferPool {
  public:
-  explicit BufferPool(int32_t width, int32_t height, size_t pool_size);
+  explicit BufferPool(int32_t width, int32_t height, size_t pool_size,
+                      size_t max_pool_size = 0);
   virtual ~BufferPool();
 
   virtual BufferUnit* GetAvailableBuffer();
   virtual void Release(BufferUnit* buffer);
 
-  void Prepare(int32_t with, int32_t height);
+  // Sets the size of the frames to be rendered. Buffers are not touched here
+  // but resized lazily when they are obtained next time, so that a buffer
+  // still read by the engine is never freed. Surfaces are reallocated
+  // outside the pool lock, so a resize never blocks Release().
+  void Prepare(int32_t width, int32_t height);
+
+  // The number of surfaces reallocated because of size changes.
+  size_t reallocation_count() const { return reallocation_count_; }
+
+  // The time spent on reallocating surfaces, which delays the frames that
+  // obtained the buffers.
+  std::chrono::microseconds reallocation_time() const {
+    return std::chrono::microseconds(reallocation_time_us_);
+  }
+  std::chrono::microseconds max_reallocation_time() const {
+    return std::chrono::microseconds(max_reallocation_time_us_);
+  }
+
+  // The number of times no buffer was available.
+  size_t exhausted_count() const { return exhausted_count_; }
+
+  size_t size() const { return pool_.size(); }
 
  protected:
+  // Resizes |buffer| to |width| x |height|. Must be called without |mutex_|
+  // held and with |buffer| marked in use, so that no other thread touches it.
+  void ResetBuffer(BufferUnit* buffer, int32_t width, int32_t height);
+
   std::vector<std::unique_ptr<BufferUnit>> pool_;
+  std::mutex mutex_;
+  int32_t width_ = 0;
+  int32_t height_ = 0;
 
  private:
+  bool CanGrow();
+  // Removes a free buffer other than |keep| from the pool. The caller frees
+  // the returned buffer, preferably without holding |mutex_|.
+  std::unique_ptr<BufferUnit> TryShrink(const BufferUnit* keep);
+
   size_t last_index_ = 0;
-  std::mutex mutex_;
+  size_t min_pool_size_ = 0;
+  size_t max_pool_size_ = 0;
+  std::atomic<size_t> reallocation_count_ = 0;
+  std::atomic<int64_t> reallocation_time_us_ = 0;
+  std::atomic<int64_t> max_reallocation_time_us_ = 0;
+  size_t exhausted_count_ = 0;
+  // Shortages since the pool last changed its size or had a long enough run
+  // without shortage.
+  size_t recent_exhausted_count_ = 0;
+  size_t frames_since_exhausted_ = 0;
 };
 
 class SingleBufferPool : public BufferPool {
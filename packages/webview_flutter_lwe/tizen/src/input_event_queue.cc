@@ -0,0 +1,29 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "input_event_queue.h"
+
+bool InputEventQueue::Push(const InputEvent& event) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  size_t next = (tail + 1) % kCapacity;
+  if (next == head_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  events_[tail] = event;
+  tail_.store(next, std::memory_order_release);
+  return true;
+}
+
+const InputEvent* InputEventQueue::Front() {
+  size_t head = head_.load(std::memory_order_relaxed);
+  if (head == tail_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return &events_[head];
+}
+
+void InputEventQueue::Pop() {
+  size_t head = head_.load(std::memory_order_relaxed);
+  head_.store((head + 1) % kCapacity, std::memory_order_release);
+}
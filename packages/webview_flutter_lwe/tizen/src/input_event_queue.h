@@ -0,0 +1,52 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_INPUT_EVENT_QUEUE_H_
+#define FLUTTER_PLUGIN_INPUT_EVENT_QUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#include "lwe/PlatformIntegrationData.h"
+
+struct InputEvent {
+  enum class Type { kKeyDown, kKeyUp, kMouseDown, kMouseMove, kMouseUp };
+
+  Type type = Type::kKeyDown;
+  LWE::KeyValue key_value = LWE::KeyValue::UnidentifiedKey;
+  LWE::MouseButtonValue button = LWE::MouseButtonValue::NoButton;
+  LWE::MouseButtonsValue buttons = LWE::MouseButtonsValue::NoButtonDown;
+  double x = 0.0;
+  double y = 0.0;
+  std::chrono::steady_clock::time_point time;
+};
+
+// A fixed-size lock-free queue of input events with a single producer (the
+// platform thread) and a single consumer (the LWE thread).
+class InputEventQueue {
+ public:
+  // Returns false if the queue is full.
+  bool Push(const InputEvent& event);
+
+  // Returns the oldest event without removing it, or nullptr if the queue is
+  // empty. Must only be called by the consumer.
+  const InputEvent* Front();
+
+  // Removes the oldest event. Must only be called by the consumer after
+  // Front() returned an event.
+  void Pop();
+
+ private:
+  static constexpr size_t kCapacity = 64;
+
+  std::array<InputEvent, kCapacity> events_;
+  // The index of the next event to be read. Written by the consumer.
+  std::atomic<size_t> head_ = 0;
+  // The index of the next event to be written. Written by the producer.
+  std::atomic<size_t> tail_ = 0;
+};
+
+#endif  // FLUTTER_PLUGIN_INPUT_EVENT_QUEUE_H_
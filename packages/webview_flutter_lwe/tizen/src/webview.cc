@@ -10,6 +10,8 @@
 #include <system_info.h>
 #include <tbm_surface.h>
 
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <variant>
 
@@ -19,7 +21,9 @@
 #include "lwe/PlatformIntegrationData.h"
 #include "webview_factory.h"
 
-static constexpr size_t kBufferPoolSize = 5;
+static constexpr int32_t kBufferPoolSize = 5;
+static constexpr int32_t kMinBufferPoolSize = 2;
+static constexpr int32_t kMaxBufferPoolSize = 10;
 
 extern "C" size_t LWE_EXPORT createWebViewInstance(
     unsigned x, unsigned y, unsigned width, unsigned height,
@@ -151,18 +155,36 @@ static bool IsRunningOnEmulator() {
   return result;
 }
 
+struct WebView::Liveness {
+  std::mutex mutex;
+  WebView* webview = nullptr;
+};
+
 WebView::WebView(flutter::PluginRegistrar* registrar, int view_id,
                  flutter::TextureRegistrar* texture_registrar, double width,
                  double height, const flutter::EncodableValue& params)
     : PlatformView(registrar, view_id, nullptr),
       texture_registrar_(texture_registrar),
       width_(width),
-      height_(height) {
+      height_(height),
+      liveness_(std::make_shared<Liveness>()) {
+  liveness_->webview = this;
+  GetValueFromEncodableMap(&params, "maxFrameRate", &max_frame_rate_);
+  max_frame_rate_ = std::max(max_frame_rate_, 0);
+
   use_sw_backend_ = IsRunningOnEmulator();
   if (use_sw_backend_) {
     tbm_pool_ = std::make_unique<SingleBufferPool>(width, height);
   } else {
-    tbm_pool_ = std::make_unique<BufferPool>(width, height, kBufferPoolSize);
+    int32_t buffer_pool_size = kBufferPoolSize;
+    GetValueFromEncodableMap(&params, "bufferPoolSize", &buffer_pool_size);
+    buffer_pool_size = std::clamp(buffer_pool_size, kMinBufferPoolSize,
+                                  kMaxBufferPoolSize);
+    // Let the pool grow up to twice its size when it keeps running out of
+    // buffers.
+    tbm_pool_ = std::make_unique<BufferPool>(
+        width, height, buffer_pool_size,
+        std::min(buffer_pool_size * 2, kMaxBufferPoolSize));
   }
 
   texture_variant_ =
@@ -355,49 +377,116 @@ std::string WebView::GetChannelName() {
 
 void WebView::Dispose() {
   texture_registrar_->UnregisterTexture(GetTextureId());
+  LOG_DEBUG(
+      "Frames rendered: %zu, presented: %zu, replaced: %zu, delayed: %zu, "
+      "skipped for lack of buffers: %zu (pool size: %zu, surfaces "
+      "reallocated on resize: %zu in %lld us, at most %lld us per frame)",
+      rendered_frame_count_, presented_frame_count_, replaced_frame_count_,
+      delayed_frame_count_, tbm_pool_->exhausted_count(), tbm_pool_->size(),
+      tbm_pool_->reallocation_count(),
+      static_cast<long long>(tbm_pool_->reallocation_time().count()),
+      static_cast<long long>(tbm_pool_->max_reallocation_time().count()));
+
+  if (mouse_move_animator_) {
+    ecore_animator_del(mouse_move_animator_);
+    mouse_move_animator_ = nullptr;
+  }
 
+  {
+    std::lock_guard<std::mutex> lock(liveness_->mutex);
+    liveness_->webview = nullptr;
+  }
   if (webview_instance_) {
     webview_instance_->Destroy();
     webview_instance_ = nullptr;
   }
+  LOG_DEBUG("Input events dispatched: %zu, coalesced: %zu, queued past the "
+            "ring: %zu, max latency: %lld ms",
+            dispatched_input_event_count_, coalesced_input_event_count_,
+            overflow_input_event_count_,
+            static_cast<long long>(max_input_latency_ms_));
 }
 
 void WebView::Resize(double width, double height) {
   width_ = width;
   height_ = height;
 
-  if (candidate_surface_) {
-    candidate_surface_ = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (candidate_surface_) {
+      tbm_pool_->Release(candidate_surface_);
+      candidate_surface_ = nullptr;
+    }
   }
 
+  // Only records the new size. Buffers are resized when they are obtained for
+  // the next frame, off the platform thread.
   tbm_pool_->Prepare(width_, height_);
   webview_instance_->ResizeTo(width_, height_);
 }
 
 void WebView::Touch(int type, int button, double x, double y, double dx,
                     double dy) {
+  if (type == 1) {  // move event
+    pending_mouse_x_ = x;
+    pending_mouse_y_ = y;
+    has_pending_mouse_move_ = true;
+    if (!mouse_move_animator_) {
+      mouse_move_animator_ =
+          ecore_animator_add(&WebView::OnMouseMoveFrame, this);
+    }
+    return;
+  }
+
+  // Deliver the last move before the button goes down or up again.
+  FlushPendingMouseMove();
+  InputEvent event;
+  event.x = x;
+  event.y = y;
   if (type == 0) {  // down event
-    webview_instance_->DispatchMouseDownEvent(
-        LWE::MouseButtonValue::LeftButton,
-        LWE::MouseButtonsValue::LeftButtonDown, x, y);
+    event.type = InputEvent::Type::kMouseDown;
+    event.button = LWE::MouseButtonValue::LeftButton;
+    event.buttons = LWE::MouseButtonsValue::LeftButtonDown;
+    QueueInputEvent(event);
     is_mouse_lbutton_down_ = true;
-  } else if (type == 1) {  // move event
-    webview_instance_->DispatchMouseMoveEvent(
-        is_mouse_lbutton_down_ ? LWE::MouseButtonValue::LeftButton
-                               : LWE::MouseButtonValue::NoButton,
-        is_mouse_lbutton_down_ ? LWE::MouseButtonsValue::LeftButtonDown
-                               : LWE::MouseButtonsValue::NoButtonDown,
-        x, y);
   } else if (type == 2) {  // up event
-    webview_instance_->DispatchMouseUpEvent(
-        LWE::MouseButtonValue::NoButton, LWE::MouseButtonsValue::NoButtonDown,
-        x, y);
+    event.type = InputEvent::Type::kMouseUp;
+    event.button = LWE::MouseButtonValue::NoButton;
+    event.buttons = LWE::MouseButtonsValue::NoButtonDown;
+    QueueInputEvent(event);
     is_mouse_lbutton_down_ = false;
   } else {
     LOG_WARN("Unknown touch event type: %d", type);
   }
 }
 
+void WebView::FlushPendingMouseMove() {
+  if (mouse_move_animator_) {
+    ecore_animator_del(mouse_move_animator_);
+    mouse_move_animator_ = nullptr;
+  }
+  if (has_pending_mouse_move_) {
+    has_pending_mouse_move_ = false;
+    InputEvent event;
+    event.type = InputEvent::Type::kMouseMove;
+    event.button = is_mouse_lbutton_down_ ? LWE::MouseButtonValue::LeftButton
+                                          : LWE::MouseButtonValue::NoButton;
+    event.buttons = is_mouse_lbutton_down_
+                        ? LWE::MouseButtonsValue::LeftButtonDown
+                        : LWE::MouseButtonsValue::NoButtonDown;
+    event.x = pending_mouse_x_;
+    event.y = pending_mouse_y_;
+    QueueInputEvent(event);
+  }
+}
+
+Eina_Bool WebView::OnMouseMoveFrame(void* data) {
+  WebView* webview = static_cast<WebView*>(data);
+  webview->mouse_move_animator_ = nullptr;
+  webview->FlushPendingMouseMove();
+  return ECORE_CALLBACK_CANCEL;
+}
+
 static LWE::KeyValue KeyToKeyValue(const std::string& key,
                                    bool is_shift_pressed) {
   if (key == "Left") {
@@ -599,40 +688,148 @@ bool WebView::SendKey(const char* key, const char* string, const char* compose,
   }
 
   bool is_shift_pressed = modifiers & 1;
+  LWE::KeyValue key_value = KeyToKeyValue(key, is_shift_pressed);
 
-  struct Param {
-    LWE::WebContainer* webview_instance;
-    LWE::KeyValue key_value;
-    bool is_down;
-  };
-
-  Param* param = new Param();
-  param->webview_instance = webview_instance_;
-  param->key_value = KeyToKeyValue(key, is_shift_pressed);
-  param->is_down = is_down;
-
-  if (param->key_value == LWE::KeyValue::TVReturnKey &&
+  if (key_value == LWE::KeyValue::TVReturnKey &&
       webview_instance_->CanGoBack()) {
     webview_instance_->GoBack();
     return true;
   }
 
-  webview_instance_->AddIdleCallback(
-      [](void* data) {
-        Param* param = reinterpret_cast<Param*>(data);
-        if (param->is_down) {
-          param->webview_instance->DispatchKeyDownEvent(param->key_value);
-          param->webview_instance->DispatchKeyPressEvent(param->key_value);
-        } else {
-          param->webview_instance->DispatchKeyUpEvent(param->key_value);
-        }
-        delete param;
-      },
-      param);
+  InputEvent event;
+  event.type = is_down ? InputEvent::Type::kKeyDown : InputEvent::Type::kKeyUp;
+  event.key_value = key_value;
+  QueueInputEvent(event);
 
   return false;
 }
 
+void WebView::QueueInputEvent(InputEvent event) {
+  event.time = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(overflow_input_events_mutex_);
+    if (!overflow_input_events_.empty() || !input_events_.Push(event)) {
+      InputEvent* last = overflow_input_events_.empty()
+                             ? nullptr
+                             : &overflow_input_events_.back();
+      if (last && last->type == InputEvent::Type::kMouseMove &&
+          event.type == InputEvent::Type::kMouseMove) {
+        // Only the latest position matters. The time of the first move is
+        // kept for the latency statistics.
+        last->x = event.x;
+        last->y = event.y;
+        last->button = event.button;
+        last->buttons = event.buttons;
+      } else if (last && last->type == InputEvent::Type::kKeyDown &&
+                 event.type == InputEvent::Type::kKeyDown &&
+                 last->key_value == event.key_value) {
+        // A key repeat.
+      } else {
+        // Never drop a down or up event, or the page sees a stuck key or
+        // button.
+        overflow_input_events_.push_back(event);
+      }
+      overflow_input_event_count_++;
+    }
+  }
+  if (!is_input_drain_scheduled_.exchange(true)) {
+    webview_instance_->AddIdleCallback(&WebView::DrainInputEvents,
+                                       NewCallbackData());
+  }
+}
+
+void WebView::DrainInputEvents(void* data) {
+  RunIfAlive(data, [](WebView* webview) {
+    // Events queued from now on need another callback.
+    webview->is_input_drain_scheduled_ = false;
+
+    while (true) {
+      while (const InputEvent* front = webview->input_events_.Front()) {
+        InputEvent event = *front;
+        webview->input_events_.Pop();
+
+        if (event.type == InputEvent::Type::kKeyDown) {
+          // Key repeats that piled up while the engine was busy are
+          // dispatched once, so that a held key does not keep acting after it
+          // is released.
+          const InputEvent* next;
+          while ((next = webview->input_events_.Front()) &&
+                 next->type == InputEvent::Type::kKeyDown &&
+                 next->key_value == event.key_value) {
+            webview->input_events_.Pop();
+            webview->coalesced_input_event_count_++;
+          }
+        }
+        webview->DispatchInputEvent(event);
+      }
+
+      // Nothing is pushed to the ring while the overflow is not empty, so
+      // once the ring is drained the overflowed events are the oldest ones.
+      std::deque<InputEvent> overflow;
+      {
+        std::lock_guard<std::mutex> lock(webview->overflow_input_events_mutex_);
+        if (webview->input_events_.Front()) {
+          continue;
+        }
+        overflow.swap(webview->overflow_input_events_);
+      }
+      if (overflow.empty()) {
+        break;
+      }
+      for (const InputEvent& event : overflow) {
+        webview->DispatchInputEvent(event);
+      }
+    }
+  });
+}
+
+void WebView::DispatchInputEvent(const InputEvent& event) {
+  LWE::WebContainer* container = webview_instance_;
+  switch (event.type) {
+    case InputEvent::Type::kKeyDown:
+      container->DispatchKeyDownEvent(event.key_value);
+      container->DispatchKeyPressEvent(event.key_value);
+      break;
+    case InputEvent::Type::kKeyUp:
+      container->DispatchKeyUpEvent(event.key_value);
+      break;
+    case InputEvent::Type::kMouseDown:
+      container->DispatchMouseDownEvent(event.button, event.buttons, event.x,
+                                        event.y);
+      break;
+    case InputEvent::Type::kMouseMove:
+      container->DispatchMouseMoveEvent(event.button, event.buttons, event.x,
+                                        event.y);
+      break;
+    case InputEvent::Type::kMouseUp:
+      container->DispatchMouseUpEvent(event.button, event.buttons, event.x,
+                                      event.y);
+      break;
+  }
+
+  auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - event.time)
+                     .count();
+  dispatched_input_event_count_++;
+  max_input_latency_ms_ =
+      std::max(max_input_latency_ms_, static_cast<int64_t>(latency));
+}
+
+void* WebView::NewCallbackData() {
+  // Leaks if the LWE thread never runs the callback, which only happens when
+  // the instance is destroyed first.
+  return new std::shared_ptr<Liveness>(liveness_);
+}
+
+void WebView::RunIfAlive(void* data, void (*callback)(WebView*)) {
+  std::unique_ptr<std::shared_ptr<Liveness>> liveness(
+      static_cast<std::shared_ptr<Liveness>*>(data));
+  std::lock_guard<std::mutex> lock((*liveness)->mutex);
+  if ((*liveness)->webview) {
+    callback((*liveness)->webview);
+  }
+}
+
 void WebView::SetDirection(int direction) {
   // TODO: Implement if necessary.
 }
@@ -646,9 +843,10 @@ void WebView::InitWebView() {
   float pixel_ratio = 1.0;
 
   auto on_prepare_image = [this]() -> LWE::WebContainer::ExternalImageInfo {
-    std::lock_guard<std::mutex> lock(mutex_);
     LWE::WebContainer::ExternalImageInfo result;
     if (!working_surface_) {
+      // May reallocate the surface of the buffer, so |mutex_| is not held
+      // here to not block the raster thread.
       working_surface_ = tbm_pool_->GetAvailableBuffer();
     }
     if (working_surface_) {
@@ -661,13 +859,23 @@ void WebView::InitWebView() {
   auto on_flush = [this](LWE::WebContainer* container, bool is_rendered) {
     if (is_rendered) {
       std::lock_guard<std::mutex> lock(mutex_);
+      if (!working_surface_) {
+        return;
+      }
+      rendered_frame_count_++;
       if (candidate_surface_) {
+        // The previous frame was never displayed.
+        if (is_frame_timeout_pending_) {
+          delayed_frame_count_++;
+        } else {
+          replaced_frame_count_++;
+        }
         tbm_pool_->Release(candidate_surface_);
         candidate_surface_ = nullptr;
       }
       candidate_surface_ = working_surface_;
       working_surface_ = nullptr;
-      texture_registrar_->MarkTextureFrameAvailable(GetTextureId());
+      MarkFrameAvailable();
     }
   };
 
@@ -863,11 +1071,43 @@ void WebView::HandleCookieMethodCall(
   }
 }
 
+void WebView::MarkFrameAvailable() {
+  if (is_frame_timeout_pending_) {
+    // The pending timeout will present the latest frame.
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  if (max_frame_rate_ > 0) {
+    auto interval = std::chrono::microseconds(1000000 / max_frame_rate_);
+    auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        interval - (now - last_frame_time_));
+    if (remaining.count() > 0) {
+      is_frame_timeout_pending_ = true;
+      webview_instance_->AddTimeout(
+          [](void* data) {
+            RunIfAlive(data, [](WebView* webview) {
+              std::lock_guard<std::mutex> lock(webview->mutex_);
+              webview->is_frame_timeout_pending_ = false;
+              webview->last_frame_time_ = std::chrono::steady_clock::now();
+              webview->texture_registrar_->MarkTextureFrameAvailable(
+                  webview->GetTextureId());
+            });
+          },
+          NewCallbackData(), remaining.count());
+      return;
+    }
+  }
+  last_frame_time_ = now;
+  texture_registrar_->MarkTextureFrameAvailable(GetTextureId());
+}
+
 FlutterDesktopGpuSurfaceDescriptor* WebView::ObtainGpuSurface(size_t width,
                                                               size_t height) {
   std::lock_guard<std::mutex> lock(mutex_);
   if (!candidate_surface_) {
     if (rendered_surface_) {
+      rendered_surface_->MarkHeldByEngine();
       return rendered_surface_->GpuSurface();
     }
     return nullptr;
@@ -877,5 +1117,7 @@ FlutterDesktopGpuSurfaceDescriptor* WebView::ObtainGpuSurface(size_t width,
   }
   rendered_surface_ = candidate_surface_;
   candidate_surface_ = nullptr;
+  presented_frame_count_++;
+  rendered_surface_->MarkHeldByEngine();
   return rendered_surface_->GpuSurface();
 }
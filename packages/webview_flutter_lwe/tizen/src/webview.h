@@ -5,6 +5,7 @@
 #ifndef FLUTTER_PLUGIN_WEBVIEW_H_
 #define FLUTTER_PLUGIN_WEBVIEW_H_
 
+#include <Ecore.h>
 #include <flutter/encodable_value.h>
 #include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
@@ -12,11 +13,17 @@
 #include <flutter/texture_registrar.h>
 #include <flutter_platform_view.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
 
+#include "input_event_queue.h"
+
 namespace LWE {
 class WebContainer;
 }
@@ -63,14 +70,63 @@ class WebView : public PlatformView {
 
   void InitWebView();
 
+  // Shared with the callbacks posted to the LWE thread, which cannot be
+  // removed once added. Dispose() clears it so that they do nothing.
+  struct Liveness;
+
+  // Returns the data of a callback to be run with RunIfAlive().
+  void* NewCallbackData();
+  // Calls |callback| unless the webview has been disposed, and frees |data|.
+  static void RunIfAlive(void* data, void (*callback)(WebView*));
+
+  // Queues |event| to be dispatched on the LWE thread.
+  void QueueInputEvent(InputEvent event);
+  static void DrainInputEvents(void* data);
+  void DispatchInputEvent(const InputEvent& event);
+
+  // Notifies Flutter of a new frame, at most |max_frame_rate_| times per
+  // second. Must be called on the LWE thread with |mutex_| held.
+  void MarkFrameAvailable();
+
+  void FlushPendingMouseMove();
+  static Eina_Bool OnMouseMoveFrame(void* data);
+
   LWE::WebContainer* webview_instance_ = nullptr;
   flutter::TextureRegistrar* texture_registrar_;
   double width_;
   double height_;
+  // Only accessed on the LWE thread.
   BufferUnit* working_surface_ = nullptr;
+  // Guarded by |mutex_|.
   BufferUnit* candidate_surface_ = nullptr;
   BufferUnit* rendered_surface_ = nullptr;
+  size_t rendered_frame_count_ = 0;
+  size_t presented_frame_count_ = 0;
+  // Frames replaced by a newer frame before being presented. Those held back
+  // by the frame rate cap are counted as delayed instead.
+  size_t replaced_frame_count_ = 0;
+  size_t delayed_frame_count_ = 0;
+  // 0 means unlimited.
+  int32_t max_frame_rate_ = 0;
+  std::chrono::steady_clock::time_point last_frame_time_;
+  bool is_frame_timeout_pending_ = false;
   bool is_mouse_lbutton_down_ = false;
+  // Move events are coalesced and dispatched once per frame.
+  Ecore_Animator* mouse_move_animator_ = nullptr;
+  bool has_pending_mouse_move_ = false;
+  double pending_mouse_x_ = 0.0;
+  double pending_mouse_y_ = 0.0;
+  InputEventQueue input_events_;
+  std::atomic<bool> is_input_drain_scheduled_ = false;
+  // Holds the events that arrive while |input_events_| is full, and every
+  // event after them until it is drained, so that the order is kept.
+  std::deque<InputEvent> overflow_input_events_;
+  std::mutex overflow_input_events_mutex_;
+  size_t overflow_input_event_count_ = 0;
+  // Only accessed by the LWE thread until the instance is destroyed.
+  size_t dispatched_input_event_count_ = 0;
+  size_t coalesced_input_event_count_ = 0;
+  int64_t max_input_latency_ms_ = 0;
   bool has_navigation_delegate_ = false;
   bool has_progress_tracking_ = false;
   std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>> channel_;
@@ -78,6 +134,7 @@ class WebView : public PlatformView {
   std::mutex mutex_;
   std::unique_ptr<BufferPool> tbm_pool_;
   bool use_sw_backend_;
+  std::shared_ptr<Liveness> liveness_;
 };
 
 #endif  // FLUTTER_PLUGIN_WEBVIEW_H_
@@ -7,6 +7,7 @@
 #include <app_common.h>
 #include <flutter/encodable_value.h>
 #include <flutter/message_codec.h>
+#include <flutter/standard_method_codec.h>
 
 #include <string>
 #include <variant>
@@ -15,6 +16,13 @@
 #include "lwe/LWEWebView.h"
 #include "webview.h"
 
+namespace {
+
+constexpr char kWebViewFactoryChannelName[] =
+    "plugins.flutter.io/webview_lwe_factory";
+
+}  // namespace
+
 static std::string GetAppDataPath() {
   char* path = app_get_data_path();
   if (!path) {
@@ -28,20 +36,67 @@ static std::string GetAppDataPath() {
 WebViewFactory::WebViewFactory(flutter::PluginRegistrar* registrar)
     : PlatformViewFactory(registrar) {
   texture_registrar_ = registrar->texture_registrar();
+  cache_path_ = GetAppDataPath() + "Starfish_cache.db";
 
-  std::string data_path = GetAppDataPath();
-  std::string local_storage_path = data_path + "StarFish_localStorage.db";
-  std::string cookie_path = data_path + "StarFish_cookies.db";
-  std::string cache_path = data_path + "Starfish_cache.db";
-
-  LWE::LWE::Initialize(local_storage_path.c_str(), cookie_path.c_str(),
-                       cache_path.c_str());
+  channel_ = std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+      registrar->messenger(), kWebViewFactoryChannelName,
+      &flutter::StandardMethodCodec::GetInstance());
+  channel_->SetMethodCallHandler([this](const auto& call, auto result) {
+    HandleMethodCall(call, std::move(result));
+  });
 }
 
 PlatformView* WebViewFactory::Create(int view_id, double width, double height,
                                      const ByteMessage& params) {
+  InitializeEngine();
   return new WebView(GetPluginRegistrar(), view_id, texture_registrar_, width,
                      height, *GetCodec().DecodeMessage(params));
 }
 
-void WebViewFactory::Dispose() { LWE::LWE::Finalize(); }
+void WebViewFactory::Dispose() {
+  if (LWE::LWE::IsInitialized()) {
+    LWE::LWE::Finalize();
+  }
+}
+
+void WebViewFactory::HandleMethodCall(
+    const flutter::MethodCall<flutter::EncodableValue>& method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const std::string& method_name = method_call.method_name();
+  const flutter::EncodableValue* arguments = method_call.arguments();
+
+  if (method_name == "setCacheDirectory") {
+    const auto* directory = std::get_if<std::string>(arguments);
+    if (!directory || directory->empty()) {
+      result->Error("Invalid argument", "The argument must be a path.");
+      return;
+    }
+    if (LWE::LWE::IsInitialized()) {
+      result->Error("Invalid operation",
+                    "The cache directory must be set before the first web "
+                    "view is created.");
+      return;
+    }
+    cache_path_ = *directory;
+    if (cache_path_.back() != '/') {
+      cache_path_ += '/';
+    }
+    cache_path_ += "Starfish_cache.db";
+    result->Success();
+  } else {
+    result->NotImplemented();
+  }
+}
+
+void WebViewFactory::InitializeEngine() {
+  if (LWE::LWE::IsInitialized()) {
+    return;
+  }
+  std::string data_path = GetAppDataPath();
+  std::string local_storage_path = data_path + "StarFish_localStorage.db";
+  std::string cookie_path = data_path + "StarFish_cookies.db";
+
+  LWE::LWE::Initialize(local_storage_path.c_str(), cookie_path.c_str(),
+                       cache_path_.c_str());
+  LOG_DEBUG("HTTP cache: %s", cache_path_.c_str());
+}
@@ -5,10 +5,14 @@
 #ifndef FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
 #define FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
 
+#include <flutter/encodable_value.h>
+#include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
 #include <flutter/texture_registrar.h>
 #include <flutter_platform_view.h>
 
+#include <memory>
+#include <string>
 #include <vector>
 
 class WebViewFactory : public PlatformViewFactory {
@@ -21,7 +25,17 @@ class WebViewFactory : public PlatformViewFactory {
   virtual void Dispose() override;
 
  private:
+  void HandleMethodCall(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+  // The engine can be initialized only once per process, so the cache
+  // configuration cannot change after the first web view is created.
+  void InitializeEngine();
+
   flutter::TextureRegistrar* texture_registrar_;
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>> channel_;
+  std::string cache_path_;
 };
 
 #endif  // FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_